@@ -0,0 +1,127 @@
+/************************************************************************
+ Ligne à retard multi-lecteurs : un historique d'entrée partagé, lu par
+ plusieurs jeux de taps sinc indépendants (tau1, tau2, alpha, K).
+ ************************************************************************/
+
+#ifndef MULTI_READER_SINC_DELAY_H
+#define MULTI_READER_SINC_DELAY_H
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "MultiTapSincDelay.h"
+
+/**
+ * Ligne à retard à une écriture et plusieurs lectures : quand plusieurs sorties lisent
+ * le même signal d'entrée (une source vers plusieurs haut-parleurs, par exemple),
+ * l'historique n'est stocké et écrit qu'une fois au lieu d'une fois par sortie.
+ * Chaque lecteur (SincTapReader) a ses propres tau1, tau2, alpha et K.
+ * Le buffer utilise toujours la disposition Mirrored (lectures tap par tap).
+ * @param T Le type des échantillons.
+ * @param P Le type des paramètres (voir MultiTapSincDelay).
+ */
+template <typename T = double, typename P = double>
+class MultiReaderSincDelay {
+   public:
+    using Reader = SincTapReader<T, P>;
+
+    static constexpr size_t kMaxBlockSize = SincDelayBuffer<T>::kMaxBlockSize;
+
+    /**
+     * Constructeur.
+     * @param max_delay_samples Délai maximal (en échantillons), commun à tous les lecteurs.
+     * @param num_readers Le nombre de lecteurs (sorties).
+     * @param initial_K Valeur initiale du paramètre K de chaque lecteur.
+     */
+    MultiReaderSincDelay(size_t max_delay_samples, size_t num_readers, int initial_K = 1,
+                         P sample_rate = 44100.0)
+        : m_buffer(max_delay_samples, BufferLayout::Mirrored), m_sampleRate(sample_rate)
+    {
+        if (num_readers == 0) {
+            MTSD_THROW(std::invalid_argument, "Number of readers must be greater than 0.");
+        }
+        m_readers.assign(num_readers, Reader(max_delay_samples, initial_K));
+        m_fixed.resize(num_readers);
+        m_ramp.resize(num_readers);
+    }
+
+    /**
+     * Retourne le nombre de lecteurs.
+     */
+    size_t numReaders() const { return m_readers.size(); }
+
+    /**
+     * Retourne un lecteur, pour régler ses paramètres (setTau1, setTau2, setAlpha,
+     * rampAlpha, setK, useGainTable). Les paramètres sont pris en compte au bloc suivant.
+     */
+    Reader&       reader(size_t r) { return m_readers.at(r); }
+    const Reader& reader(size_t r) const { return m_readers.at(r); }
+
+    /**
+     * Traite un bloc d'échantillons : l'entrée est écrite une seule fois dans
+     * l'historique partagé, puis lue par chaque lecteur.
+     * Le traitement en place (in == outs[r] pour un lecteur) est supporté.
+     * @param in Le bloc d'entrée.
+     * @param outs Les blocs de sortie, un par lecteur.
+     * @param n Le nombre d'échantillons du bloc.
+     */
+    void process(const T* in, T* const* outs, size_t n) noexcept
+    {
+        // Positions et gains des taps calculés une fois par bloc et par lecteur
+        const size_t num_readers = m_readers.size();
+        for (size_t r = 0; r < num_readers; ++r) {
+            m_fixed[r] = m_readers[r].isSingleTap();
+            m_ramp[r]  = m_readers[r].isRamping();
+            if (!m_fixed[r]) {
+                m_readers[r].updateTaps(m_buffer.size());
+            }
+        }
+
+        T acc[kMaxBlockSize];
+        for (size_t start = 0; start < n; start += kMaxBlockSize) {
+            size_t count = std::min(kMaxBlockSize, n - start);
+
+            // L'entrée est lue avant l'écriture de la première sortie (traitement en place)
+            size_t writeIndex = m_buffer.writeBlock(in + start, count);
+
+            for (size_t r = 0; r < num_readers; ++r) {
+                std::fill(acc, acc + count, T(0));
+                m_readers[r].accumulate(m_buffer, writeIndex, m_fixed[r], m_ramp[r], acc,
+                                        count);
+                std::copy(acc, acc + count, outs[r] + start);
+            }
+        }
+    }
+
+    /**
+     * Retourne la taille du buffer circulaire partagé (en échantillons), hors zone de garde.
+     */
+    size_t bufferSize() const { return m_buffer.size(); }
+
+    /**
+     * Retourne le surcoût mémoire du buffer partagé (en octets) par rapport à
+     * max_delay_samples échantillons. Il ne dépend pas du nombre de lecteurs.
+     */
+    size_t memoryOverhead() const { return m_buffer.memoryOverhead(); }
+
+    /**
+     * Force le jeu d'instructions des noyaux tap par tap (voir MultiTapSincDelay).
+     */
+    void setSimdLevel(SimdLevel level) { m_buffer.setSimdLevel(level); }
+
+    /**
+     * Retourne le jeu d'instructions utilisé par les noyaux tap par tap.
+     */
+    SimdLevel simdLevel() const { return m_buffer.simdLevel(); }
+
+   private:
+    SincDelayBuffer<T>  m_buffer;  // Historique d'entrée partagé
+    std::vector<Reader> m_readers;
+    std::vector<char>   m_fixed;  // isSingleTap() de chaque lecteur pour le bloc courant
+    std::vector<char>   m_ramp;   // isRamping() de chaque lecteur au début du bloc
+    P                   m_sampleRate;
+};
+
+#endif  // MULTI_READER_SINC_DELAY_H
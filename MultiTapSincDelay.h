@@ -0,0 +1,1835 @@
+/************************************************************************
+ MultiTapSincDelay : ligne à retard variable par interpolation sinc multi-tap.
+ Voir MultiTapSincDelay.dsp pour la version Faust et la référence de l'article.
+ ************************************************************************/
+
+#ifndef MULTI_TAP_SINC_DELAY_H
+#define MULTI_TAP_SINC_DELAY_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>  // Pour size_t
+#include <cstdint>
+#include <cstring>  // Pour std::memcpy
+#include <limits>   // Pour numeric_limits
+#include <map>
+#include <memory>  // Pour std::shared_ptr
+#include <mutex>
+#include <stdexcept>  // Pour std::invalid_argument
+#include <vector>
+
+#include "MultiTapSincDelayInterpolators.h"
+#include "MultiTapSincDelaySimd.h"
+
+// Définir M_PI si non disponible (nécessaire sous Windows avec certains
+// compilateurs)
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// Erreurs de configuration : exception si elles sont activées, sinon arrêt du
+// programme (-fno-exceptions). Les méthodes try* renvoient un SincDelayStatus à la place.
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS)
+#define MTSD_THROW(type, message) throw type(message)
+#else
+#include <cstdlib>
+#define MTSD_THROW(type, message) std::abort()
+#endif
+
+/**
+ * Résultat des setters sans exception (trySetK, trySetTau1, ...).
+ */
+enum class SincDelayStatus {
+    Ok,              // Valeur appliquée telle quelle
+    Clamped,         // Valeur hors limites ramenée à la limite (ParamPolicy::Clamp)
+    OutOfRange,      // Valeur hors limites ou NaN, ignorée
+    InvalidK,        // K négatif, différent de FIXED_K ou au-delà de la capacité réservée
+    NotRealtimeSafe  // L'opération allouerait ou prendrait un verrou (table de gains)
+};
+
+/**
+ * Traitement des valeurs hors limites par les setters sans exception.
+ */
+enum class ParamPolicy {
+    Reject,  // La valeur est ignorée (SincDelayStatus::OutOfRange)
+    Clamp    // La valeur est ramenée dans les limites (SincDelayStatus::Clamped)
+};
+
+/**
+ * Valide value dans [low, high] selon policy.
+ * @return Ok, Clamped (value modifiée) ou OutOfRange (value à ignorer).
+ */
+template <typename P>
+inline SincDelayStatus checkRange(P& value, P low, P high, ParamPolicy policy) noexcept
+{
+    if (value >= low && value <= high) {
+        return SincDelayStatus::Ok;
+    }
+    if (policy == ParamPolicy::Reject || value != value) {  // NaN : jamais ramené
+        return SincDelayStatus::OutOfRange;
+    }
+    value = (value < low) ? low : high;
+    return SincDelayStatus::Clamped;
+}
+
+/**
+ * Calcule la fonction sinus cardinal normalisée sinc(x) = sin(pi*x)/(pi*x).
+ * Version de référence, un appel à std::sin par évaluation.
+ */
+inline double sinc(double x)
+{
+    if (std::abs(x) < std::numeric_limits<double>::epsilon()) {
+        return 1.0;
+    }
+    double pi_x = M_PI * x;
+    return std::sin(pi_x) / pi_x;
+}
+
+/**
+ * Calcule les 2K+2 gains hk = sinc((tk - tau) / delta) à partir de sin(pi*alpha).
+ * Comme (tk - tau) / delta = (k - K) - alpha, tous les sin(pi*x) valent
+ * ±sin(pi*alpha) : seul le dénominateur dépend du tap.
+ * @param K Le nombre de paires de taps auxiliaires.
+ * @param alpha Le facteur d'interpolation.
+ * @param sin_pi_alpha La valeur de sin(pi*alpha).
+ * @param gains Le tableau de sortie (2K+2 valeurs), de type G.
+ */
+template <typename G>
+inline void sincGains(int K, double alpha, double sin_pi_alpha, G* gains)
+{
+    int num_taps = 2 * K + 2;
+
+    for (int k = 0; k < num_taps; ++k) {
+        // sin(pi*(n - alpha)) = -(-1)^n * sin(pi*alpha)
+        int    n = k - K;
+        double x = static_cast<double>(n) - alpha;
+        if (std::abs(x) < std::numeric_limits<double>::epsilon()) {
+            gains[k] = G(1);
+        } else {
+            double sin_pi_x = (n % 2 == 0) ? -sin_pi_alpha : sin_pi_alpha;
+            gains[k]        = static_cast<G>(sin_pi_x / (M_PI * x));
+        }
+    }
+}
+
+/**
+ * Calcule les 2K+2 gains hk pour alpha, avec un seul appel à std::sin.
+ */
+template <typename G>
+inline void sincGains(int K, double alpha, G* gains)
+{
+    sincGains(K, alpha, std::sin(M_PI * alpha), gains);
+}
+
+/**
+ * Table précalculée des gains hk en fonction de alpha, pour un K donné.
+ * Les gains ne dépendent que de K et de alpha (pas de tau1/tau2) : la table
+ * contient resolution+1 vecteurs de 2K+2 gains sur alpha = i/resolution, et la
+ * lecture interpole linéairement entre deux entrées.
+ * Les tables sont construites une fois par (K, resolution) et partagées en
+ * lecture seule par toutes les instances (voir get()).
+ */
+class SincGainTable {
+   public:
+    static constexpr size_t kDefaultResolution = 1024;
+
+    /**
+     * Erreur de la table par rapport à sinc() exact.
+     */
+    struct ErrorReport {
+        double maxAbsError;  // Erreur absolue maximale sur tous les taps
+        double rmsError;     // Erreur quadratique moyenne sur tous les taps
+    };
+
+    /**
+     * Constructeur.
+     * @param K Le nombre de paires de taps auxiliaires.
+     * @param resolution Le nombre d'intervalles de quantification de alpha sur [0, 1].
+     */
+    SincGainTable(int K, size_t resolution = kDefaultResolution)
+        : m_K(K), m_num_taps(2 * K + 2), m_resolution(resolution)
+    {
+        if (K < 0) {
+            MTSD_THROW(std::invalid_argument, "K cannot be negative.");
+        }
+        if (resolution == 0) {
+            MTSD_THROW(std::invalid_argument, "Table resolution must be greater than 0.");
+        }
+        m_table.resize((m_resolution + 1) * static_cast<size_t>(m_num_taps));
+        for (size_t i = 0; i <= m_resolution; ++i) {
+            double alpha = static_cast<double>(i) / static_cast<double>(m_resolution);
+            sincGains(m_K, alpha, &m_table[i * static_cast<size_t>(m_num_taps)]);
+        }
+    }
+
+    /**
+     * Retourne la table partagée pour (K, resolution), construite au premier appel.
+     * Alloue et prend un verrou : à appeler hors du thread audio.
+     */
+    static std::shared_ptr<const SincGainTable> get(int K, size_t resolution = kDefaultResolution)
+    {
+        static std::mutex mutex;
+        static std::map<std::pair<int, size_t>, std::weak_ptr<const SincGainTable>> cache;
+
+        std::lock_guard<std::mutex>          lock(mutex);
+        std::weak_ptr<const SincGainTable>&  entry = cache[std::make_pair(K, resolution)];
+        std::shared_ptr<const SincGainTable> table = entry.lock();
+        if (!table) {
+            table = std::make_shared<const SincGainTable>(K, resolution);
+            entry = table;
+        }
+        return table;
+    }
+
+    /**
+     * Lit les 2K+2 gains pour alpha, par interpolation linéaire entre deux entrées.
+     * @param alpha Le facteur d'interpolation dans [0, 1].
+     * @param gains Le tableau de sortie (2K+2 valeurs), de type G.
+     */
+    template <typename G>
+    void gains(double alpha, G* gains) const
+    {
+        double pos   = alpha * static_cast<double>(m_resolution);
+        size_t index = std::min(static_cast<size_t>(pos), m_resolution - 1);
+        double frac  = pos - static_cast<double>(index);
+
+        const double* row0 = &m_table[index * static_cast<size_t>(m_num_taps)];
+        const double* row1 = row0 + m_num_taps;
+        for (int k = 0; k < m_num_taps; ++k) {
+            gains[k] = static_cast<G>(row0[k] + frac * (row1[k] - row0[k]));
+        }
+    }
+
+    /**
+     * Mesure l'erreur de la table par rapport à sinc((k - K) - alpha) exact.
+     * @param probes Le nombre de points testés par intervalle de la table.
+     */
+    ErrorReport errorReport(size_t probes = 16) const
+    {
+        std::vector<double> gains(static_cast<size_t>(m_num_taps));
+        double              max_error = 0.0;
+        double              sum_sq    = 0.0;
+        size_t              count     = 0;
+        size_t              steps     = m_resolution * probes;
+
+        for (size_t i = 0; i <= steps; ++i) {
+            double alpha = static_cast<double>(i) / static_cast<double>(steps);
+            this->gains(alpha, gains.data());
+            for (int k = 0; k < m_num_taps; ++k) {
+                double error = std::abs(gains[k] - sinc(static_cast<double>(k - m_K) - alpha));
+                max_error    = std::max(max_error, error);
+                sum_sq += error * error;
+                ++count;
+            }
+        }
+        return ErrorReport{max_error, std::sqrt(sum_sq / static_cast<double>(count))};
+    }
+
+    int    K() const { return m_K; }
+    size_t resolution() const { return m_resolution; }
+
+   private:
+    int                 m_K;
+    int                 m_num_taps;
+    size_t              m_resolution;
+    std::vector<double> m_table;  // (resolution+1) lignes de 2K+2 gains
+};
+
+/**
+ * Disposition mémoire du buffer de délai.
+ */
+enum class BufferLayout {
+    Modulo,      // Taille exacte max_delay_samples, wrap-around par modulo et fmod
+    PowerOfTwo,  // Taille arrondie à une puissance de deux, wrap-around par masque entier
+    Mirrored     // PowerOfTwo suivi d'une zone de garde recopiant le début du buffer :
+                 // les lectures d'un tap sont contiguës, sans test de wrap-around,
+                 // et les blocs sont traités tap par tap (voir SincTapReader::accumulate)
+};
+
+/**
+ * Positions de lecture en virgule fixe 32.32 : index d'échantillon sur les 32 bits de
+ * poids fort, partie fractionnaire sur les 32 bits de poids faible. Une position
+ * relative à l'index d'écriture est calculée une fois par bloc ; chaque lecture y
+ * ajoute l'index d'écriture décalé de 32 bits, puis le wrap-around se fait sur la
+ * partie entière par masque. La résolution (2^-32 échantillon) ne dépend pas de
+ * l'index, contrairement à writeIndex - tk en virgule flottante.
+ */
+constexpr int      kFixedFracBits = 32;
+constexpr uint64_t kFixedOne      = uint64_t(1) << kFixedFracBits;
+constexpr uint64_t kFixedFracMask = kFixedOne - 1;
+
+/**
+ * Convertit une position positive (en échantillons, moins de 2^31) en virgule fixe
+ * 32.32, arrondie au plus proche.
+ */
+template <typename P>
+inline uint64_t toFixedPosition(P position)
+{
+    return static_cast<uint64_t>(std::llround(static_cast<double>(position) * kFixedOne));
+}
+
+/**
+ * Historique d'entrée d'une ligne à retard : buffer circulaire, index d'écriture et
+ * lectures interpolées. Il est séparé des paramètres des taps (SincTapReader) pour
+ * pouvoir être partagé par plusieurs lecteurs (voir MultiReaderSincDelay).
+ * @param T Le type des échantillons.
+ */
+template <typename T = double>
+class SincDelayBuffer {
+   public:
+    /**
+     * Taille maximale des sous-blocs traités tap par tap (disposition Mirrored).
+     */
+    static constexpr size_t kMaxBlockSize = 256;
+
+    /**
+     * Nombre maximal de points des politiques d'interpolation (voir
+     * MultiTapSincDelayInterpolators.h) lues tap par tap.
+     */
+    static constexpr size_t kMaxInterpolatorPoints = 16;
+
+    /**
+     * Étendue maximale (en échantillons) lue de façon contiguë pour un tap : un
+     * sous-bloc de lectures plus les kMaxInterpolatorPoints - 1 voisins de l'interpolation.
+     * Fixe la taille de la zone de garde de la disposition Mirrored.
+     */
+    static constexpr size_t kMaxTapSpan = kMaxBlockSize + kMaxInterpolatorPoints - 1;
+
+    /**
+     * Constructeur.
+     * @param max_delay_samples Taille maximale du buffer de délai en échantillons.
+     * @param layout Disposition mémoire du buffer (voir BufferLayout).
+     */
+    SincDelayBuffer(size_t max_delay_samples, BufferLayout layout)
+        : m_max_delay_samples(max_delay_samples),
+          m_size(0),
+          m_guard(0),
+          m_writeIndex(0),
+          m_layout(layout),
+          m_mask(0),
+          m_simdLevel(detectSimdLevel()),
+          m_tapKernel(tapKernel<T>(m_simdLevel)),
+          m_modulatedTapKernel(modulatedTapKernel<T>(m_simdLevel))
+    {
+        if (max_delay_samples == 0) {
+            MTSD_THROW(std::invalid_argument, "Max delay samples must be greater than 0.");
+        }
+        if (m_layout == BufferLayout::Modulo) {
+            m_size = max_delay_samples;
+        } else if (m_layout == BufferLayout::PowerOfTwo) {
+            m_size = nextPowerOfTwo(max_delay_samples);
+        } else {
+            // Un sous-bloc entier est écrit avant d'être lu : le buffer doit garder
+            // max_delay_samples échantillons d'historique en plus du sous-bloc
+            m_size  = nextPowerOfTwo(max_delay_samples + kMaxBlockSize);
+            m_guard = kMaxTapSpan;
+        }
+        // Index d'écriture plus position relative (au plus 2 * m_size) : la somme doit
+        // tenir dans la partie entière des positions en virgule fixe (voir splitFixed), et
+        // une position de 2^31 ou plus dépasserait std::llround dans toFixedPosition
+        if (static_cast<uint64_t>(m_size) >= (uint64_t(1) << (63 - kFixedFracBits))) {
+            MTSD_THROW(std::invalid_argument,
+                       "Max delay samples too large for 32.32 fixed-point positions.");
+        }
+        m_mask = (m_layout == BufferLayout::Modulo) ? 0 : m_size - 1;
+        m_buffer.assign(m_size + m_guard, T(0));  // Initialise le buffer avec des zéros
+    }
+
+    /**
+     * Retourne la disposition mémoire du buffer de délai.
+     */
+    BufferLayout layout() const { return m_layout; }
+
+    /**
+     * Retourne la taille du buffer circulaire (en échantillons), supérieure ou
+     * égale à max_delay_samples, hors zone de garde.
+     */
+    size_t size() const { return m_size; }
+
+    /**
+     * Retourne la taille de la zone de garde (en échantillons), 0 hors disposition Mirrored.
+     * Elle est bornée par kMaxTapSpan, l'étendue maximale d'une lecture contiguë.
+     */
+    size_t guardSize() const { return m_guard; }
+
+    /**
+     * Retourne le surcoût mémoire du buffer (en octets) par rapport à
+     * max_delay_samples échantillons : arrondi à une puissance de deux et zone de garde.
+     */
+    size_t memoryOverhead() const
+    {
+        return (m_buffer.size() - m_max_delay_samples) * sizeof(T);
+    }
+
+    /**
+     * Retourne l'index d'écriture courant.
+     */
+    size_t writeIndex() const { return m_writeIndex; }
+
+    /**
+     * Force le jeu d'instructions des noyaux tap par tap (disposition Mirrored).
+     * Par défaut, le plus large supporté par le CPU est choisi à la construction ;
+     * un jeu non supporté est remplacé par le noyau scalaire.
+     */
+    void setSimdLevel(SimdLevel level)
+    {
+        m_simdLevel = simdSupported(level) ? level : SimdLevel::Scalar;
+        m_tapKernel          = tapKernel<T>(m_simdLevel);
+        m_modulatedTapKernel = modulatedTapKernel<T>(m_simdLevel);
+    }
+
+    /**
+     * Retourne le jeu d'instructions utilisé par les noyaux tap par tap.
+     */
+    SimdLevel simdLevel() const { return m_simdLevel; }
+
+    /**
+     * Écrit un échantillon à l'index d'écriture, et dans la zone de garde si
+     * l'index fait partie du début du buffer recopié (disposition Mirrored).
+     */
+    template <BufferLayout LAYOUT>
+    void writeSample(T sample)
+    {
+        m_buffer[m_writeIndex] = sample;
+        if (LAYOUT == BufferLayout::Mirrored && m_writeIndex < m_guard) {
+            m_buffer[m_size + m_writeIndex] = sample;
+        }
+    }
+
+    /**
+     * Incrémente l'index d'écriture (avec wrap-around).
+     */
+    template <BufferLayout LAYOUT>
+    void advance()
+    {
+        m_writeIndex = (LAYOUT == BufferLayout::Modulo) ? ((m_writeIndex + 1) % m_size)
+                                                        : ((m_writeIndex + 1) & m_mask);
+    }
+
+    /**
+     * Écrit un sous-bloc d'au plus kMaxBlockSize échantillons (au plus la taille du
+     * buffer hors disposition Mirrored), en deux plages au plus, plus la recopie dans
+     * la zone de garde (disposition Mirrored).
+     * @return L'index d'écriture du premier échantillon du sous-bloc.
+     */
+    size_t writeBlock(const T* in, size_t count)
+    {
+        const size_t writeIndex = m_writeIndex;
+        const size_t first      = std::min(count, m_size - writeIndex);
+        T*           buffer     = m_buffer.data();
+        for (size_t i = 0; i < first; ++i) {
+            buffer[writeIndex + i] = in[i];
+        }
+        for (size_t i = first; i < count; ++i) {
+            buffer[i - first] = in[i];
+        }
+
+        // Début du buffer recopié après la fin (zone de garde)
+        const size_t wrapped = (count > first) ? std::min(count - first, m_guard) : 0;
+        const size_t guarded = (writeIndex < m_guard) ? std::min(first, m_guard - writeIndex) : 0;
+        for (size_t i = 0; i < guarded; ++i) {
+            buffer[m_size + writeIndex + i] = in[i];
+        }
+        for (size_t i = 0; i < wrapped; ++i) {
+            buffer[m_size + i] = in[first + i];
+        }
+
+        m_writeIndex = writeIndex + count;
+        if (m_writeIndex >= m_size) {
+            m_writeIndex -= m_size;
+        }
+        return writeIndex;
+    }
+
+    /**
+     * Copie un sous-bloc déjà écrit, retardé d'un nombre entier d'échantillons, en
+     * deux copies au plus (une seule en disposition Mirrored grâce à la zone de garde).
+     * @param writeIndex L'index d'écriture du premier échantillon du sous-bloc.
+     * @param delay Le délai, au plus la taille du buffer.
+     * @param count Le nombre d'échantillons, au plus kMaxBlockSize en disposition Mirrored.
+     */
+    void readBlock(T* out, size_t writeIndex, size_t delay, size_t count) const
+    {
+        size_t start = writeIndex + m_size - delay;
+        if (start >= m_size) {
+            start -= m_size;
+        }
+        const size_t first = std::min(count, m_size + m_guard - start);
+        std::memcpy(out, &m_buffer[start], first * sizeof(T));
+        std::memcpy(out + first, &m_buffer[0], (count - first) * sizeof(T));
+    }
+
+    /**
+     * Lit un sous-bloc déjà écrit, retardé d'un délai fractionnaire fixe : filtre à
+     * kPoints coefficients constants (les poids de INTERP, deux pour l'interpolation
+     * linéaire) appliqué par le noyau tap par tap. Hors disposition Mirrored, une
+     * plage qui passe la fin du buffer est d'abord recopiée en deux copies.
+     * @param writeIndex L'index d'écriture du premier échantillon du sous-bloc.
+     * @param delay Le délai, dans [0, taille du buffer].
+     * @param count Le nombre d'échantillons (au plus kMaxBlockSize).
+     */
+    template <typename INTERP = LinearInterpolator, typename P>
+    void readFractionalBlock(T* out, size_t writeIndex, P delay, size_t count) const
+    {
+        static_assert(INTERP::kPoints <= static_cast<int>(kMaxInterpolatorPoints),
+                      "Interpolator reads past the guard zone.");
+        size_t index = 0;
+        T      frac  = T(0);
+        splitFixed(writeIndex, fixedOffset(delay), index, frac);
+
+        T coeffs[INTERP::kPoints];
+        INTERP::weights(frac, coeffs);
+
+        // Plage lue : count + kPoints - 1 échantillons à partir de index - kOrigin
+        const size_t span  = count + INTERP::kPoints - 1;
+        const size_t start = (index + m_size - INTERP::kOrigin) % m_size;
+        const T*     src   = &m_buffer[start];
+        T            points[kMaxTapSpan];
+        if (start + span > m_size + m_guard) {
+            const size_t first = m_size - start;
+            std::memcpy(points, src, first * sizeof(T));
+            std::memcpy(points + first, &m_buffer[0], (span - first) * sizeof(T));
+            src = points;
+        }
+        std::fill(out, out + count, T(0));
+        m_tapKernel(out, src, coeffs, INTERP::kPoints, count);
+    }
+
+    /**
+     * Lit une valeur dans le buffer de délai, interpolée selon la politique INTERP
+     * (linéaire par défaut, voir MultiTapSincDelayInterpolators.h).
+     * Gère le wrap-around des indices en virgule flottante ; les lignes lisent par
+     * readFixed(), à position en virgule fixe.
+     * @param readIndex L'index de lecture (potentiellement fractionnaire) relatif
+     * à l'index d'écriture courant.
+     */
+    template <BufferLayout LAYOUT, typename INTERP = LinearInterpolator, typename P>
+    T readInterpolated(P readIndex) const
+    {
+        T points[INTERP::kPoints];
+
+        if (LAYOUT != BufferLayout::Modulo) {
+            // readIndex = writeIndex - tk avec 0 <= tk <= taille du buffer (voir
+            // SincTapReader::updateTaps) : un seul décalage suffit à le rendre positif,
+            // la troncature vaut alors floor et tout le wrap-around se fait par masque
+            P      wrappedReadIndex = readIndex + static_cast<P>(m_size);
+            size_t index            = static_cast<size_t>(wrappedReadIndex);
+            T      frac             = static_cast<T>(wrappedReadIndex - static_cast<P>(index));
+
+            size_t first = index + m_size - INTERP::kOrigin;
+            for (int p = 0; p < INTERP::kPoints; ++p) {
+                points[p] = m_buffer[(first + static_cast<size_t>(p)) & m_mask];
+            }
+            return INTERP::interpolate(points, frac);
+        }
+
+        // Assurer que l'index est positif avant le modulo pour éviter les problèmes
+        // avec fmod sur nombres négatifs
+        P wrappedReadIndex = readIndex;
+        while (wrappedReadIndex < P(0)) {
+            wrappedReadIndex += static_cast<P>(m_max_delay_samples);
+        }
+        // Appliquer le modulo pour le wrap-around final
+        wrappedReadIndex = std::fmod(wrappedReadIndex, static_cast<P>(m_max_delay_samples));
+
+        // Points index0 - kOrigin .. index0 - kOrigin + kPoints - 1, avec wrap-around
+        size_t index0 = static_cast<size_t>(std::floor(wrappedReadIndex));
+        T      frac   = static_cast<T>(wrappedReadIndex - std::floor(wrappedReadIndex));
+
+        size_t first = index0 + m_max_delay_samples - INTERP::kOrigin;
+        for (int p = 0; p < INTERP::kPoints; ++p) {
+            points[p] = m_buffer[(first + static_cast<size_t>(p)) % m_max_delay_samples];
+        }
+        return INTERP::interpolate(points, frac);
+    }
+
+    /**
+     * Retourne la position en virgule fixe 32.32, relative à l'index d'écriture, d'un
+     * tap de délai tk dans [0, taille du buffer] : taille du buffer - tk, dans
+     * [0, taille du buffer] (voir readFixed).
+     */
+    template <typename P>
+    uint64_t fixedOffset(P tk) const
+    {
+        return toFixedPosition(static_cast<P>(m_size) - tk);
+    }
+
+    /**
+     * Lit une valeur interpolée selon la politique INTERP à une position en virgule
+     * fixe 32.32 (voir kFixedFracBits) : l'index d'écriture courant plus offset, moins
+     * la taille du buffer. Index et partie fractionnaire sont extraits par décalage et
+     * masque, sans floor ni fmod.
+     * @param offset La position relative (voir fixedOffset), calculée une fois par bloc.
+     */
+    template <BufferLayout LAYOUT, typename INTERP = LinearInterpolator>
+    T readFixed(uint64_t offset) const
+    {
+        size_t index = 0;
+        T      frac  = T(0);
+        splitFixed(m_writeIndex, offset, index, frac);
+        size_t first = index + m_size - INTERP::kOrigin;
+
+        T points[INTERP::kPoints];
+        if (LAYOUT != BufferLayout::Modulo) {
+            for (int p = 0; p < INTERP::kPoints; ++p) {
+                points[p] = m_buffer[(first + static_cast<size_t>(p)) & m_mask];
+            }
+            return INTERP::interpolate(points, frac);
+        }
+
+        // first < 3 * taille du buffer : deux soustractions au plus, puis une par point
+        first = (first >= m_size) ? first - m_size : first;
+        first = (first >= m_size) ? first - m_size : first;
+        for (int p = 0; p < INTERP::kPoints; ++p) {
+            size_t pos = first + static_cast<size_t>(p);
+            points[p]  = m_buffer[(pos < m_size) ? pos : pos - m_size];
+        }
+        return INTERP::interpolate(points, frac);
+    }
+
+    /**
+     * Ajoute à acc la contribution d'un tap sur un sous-bloc (disposition Mirrored),
+     * interpolée selon la politique INTERP.
+     * @param writeIndex L'index d'écriture du premier échantillon du sous-bloc.
+     * @param tk La position du tap, dans [0, taille du buffer].
+     * @param gain Le gain du tap.
+     * @param count Le nombre d'échantillons du sous-bloc (au plus kMaxBlockSize).
+     */
+    template <typename INTERP = LinearInterpolator, typename P>
+    void accumulateTap(T* acc, size_t writeIndex, P tk, T gain, size_t count) const
+    {
+        accumulateTapFixed<INTERP>(acc, writeIndex, fixedOffset(tk), gain, count);
+    }
+
+    /**
+     * Variante de accumulateTap() avec la position du tap en virgule fixe (voir
+     * fixedOffset).
+     */
+    template <typename INTERP = LinearInterpolator>
+    void accumulateTapFixed(T* acc, size_t writeIndex, uint64_t offset, T gain,
+                            size_t count) const
+    {
+        static_assert(INTERP::kPoints <= static_cast<int>(kMaxInterpolatorPoints),
+                      "Interpolator reads past the guard zone.");
+        size_t index = 0;
+        T      frac  = T(0);
+        splitFixed(writeIndex, offset, index, frac);
+
+        // Poids d'interpolation constants sur le sous-bloc, gain inclus
+        T coeffs[INTERP::kPoints];
+        INTERP::weights(frac, coeffs);
+        for (T& coeff : coeffs) {
+            coeff *= gain;
+        }
+        m_tapKernel(acc, &m_buffer[(index - INTERP::kOrigin) & m_mask], coeffs, INTERP::kPoints,
+                    count);
+    }
+
+    /**
+     * Variante de accumulateTap() avec un gain par échantillon (rampe de alpha).
+     * @param gains Les count gains du tap sur le sous-bloc.
+     */
+    template <typename INTERP = LinearInterpolator, typename P>
+    void accumulateTapModulated(T* acc, size_t writeIndex, P tk, const T* gains,
+                                size_t count) const
+    {
+        accumulateTapModulatedFixed<INTERP>(acc, writeIndex, fixedOffset(tk), gains, count);
+    }
+
+    /**
+     * Variante de accumulateTapModulated() avec la position du tap en virgule fixe.
+     */
+    template <typename INTERP = LinearInterpolator>
+    void accumulateTapModulatedFixed(T* acc, size_t writeIndex, uint64_t offset,
+                                     const T* gains, size_t count) const
+    {
+        static_assert(INTERP::kPoints <= static_cast<int>(kMaxInterpolatorPoints),
+                      "Interpolator reads past the guard zone.");
+        size_t index = 0;
+        T      frac  = T(0);
+        splitFixed(writeIndex, offset, index, frac);
+
+        T coeffs[INTERP::kPoints];
+        INTERP::weights(frac, coeffs);
+        m_modulatedTapKernel(acc, &m_buffer[(index - INTERP::kOrigin) & m_mask], coeffs, gains,
+                             INTERP::kPoints, count);
+    }
+
+    /**
+     * Lit la somme de taps de même partie fractionnaire frac (delta entier, voir
+     * SincTapReader::setDeltaSnapTolerance) : les points des taps sont pondérés par
+     * leurs gains et sommés, puis interpolés une seule fois, sans floor ni frac par tap.
+     * @param offsets Les décalages entiers des taps, dans [0, taille du buffer) : le
+     * premier point du tap k est à l'index writeIndex + offsets[k], modulo la taille du
+     * buffer.
+     * @param gains Les gains des taps.
+     * @param taps Les index des taps lus (num_taps valeurs).
+     * @param frac La partie fractionnaire commune des lectures.
+     */
+    template <BufferLayout LAYOUT, typename INTERP = LinearInterpolator>
+    T readIntegerTaps(const size_t* offsets, const T* gains, const int* taps, int num_taps,
+                      T frac) const
+    {
+        T points[INTERP::kPoints] = {};
+        for (int a = 0; a < num_taps; ++a) {
+            const int k     = taps[a];
+            size_t    first = m_writeIndex + offsets[k];
+            if (LAYOUT == BufferLayout::Modulo && first >= m_size) {
+                first -= m_size;
+            }
+            for (int p = 0; p < INTERP::kPoints; ++p) {
+                size_t pos = first + static_cast<size_t>(p);
+                if (LAYOUT == BufferLayout::Modulo) {
+                    pos = (pos < m_size) ? pos : pos - m_size;
+                } else {
+                    pos &= m_mask;
+                }
+                points[p] += gains[k] * m_buffer[pos];
+            }
+        }
+        return INTERP::interpolate(points, frac);
+    }
+
+    /**
+     * Variante de readIntegerTaps() sur un sous-bloc (disposition Mirrored) : les taps
+     * sont d'abord sommés à délais entiers, un coefficient par tap, sur les
+     * count + kPoints - 1 échantillons lus, puis la somme est interpolée une seule fois
+     * avec les poids de frac. Coût par échantillon : un produit par tap plus kPoints,
+     * au lieu de kPoints produits par tap.
+     * @param writeIndex L'index d'écriture du premier échantillon du sous-bloc.
+     * @param count Le nombre d'échantillons du sous-bloc (au plus kMaxBlockSize).
+     */
+    template <typename INTERP = LinearInterpolator>
+    void accumulateIntegerTaps(T* acc, size_t writeIndex, const size_t* offsets, const T* gains,
+                               const int* taps, int num_taps, T frac, size_t count) const
+    {
+        static_assert(INTERP::kPoints <= static_cast<int>(kMaxInterpolatorPoints),
+                      "Interpolator reads past the guard zone.");
+        const size_t span = count + INTERP::kPoints - 1;
+        T            sums[kMaxTapSpan];
+        std::fill(sums, sums + span, T(0));
+        for (int a = 0; a < num_taps; ++a) {
+            const int k = taps[a];
+            m_tapKernel(sums, &m_buffer[(writeIndex + offsets[k]) & m_mask], &gains[k], 1, span);
+        }
+
+        T coeffs[INTERP::kPoints];
+        INTERP::weights(frac, coeffs);
+        m_tapKernel(acc, sums, coeffs, INTERP::kPoints, count);
+    }
+
+   private:
+    /**
+     * Sépare la position writeIndex + offset (virgule fixe, voir readFixed) en index,
+     * dans [0, 3 * taille du buffer), et partie fractionnaire.
+     */
+    static void splitFixed(size_t writeIndex, uint64_t offset, size_t& index, T& frac)
+    {
+        const uint64_t position = (static_cast<uint64_t>(writeIndex) << kFixedFracBits) + offset;
+        index                   = static_cast<size_t>(position >> kFixedFracBits);
+        frac                    = static_cast<T>(position & kFixedFracMask) * T(1.0 / kFixedOne);
+    }
+
+    /**
+     * Arrondit n à la puissance de deux supérieure ou égale.
+     */
+    static size_t nextPowerOfTwo(size_t n)
+    {
+        size_t size = 1;
+        while (size < n) {
+            size <<= 1;
+        }
+        return size;
+    }
+
+    size_t                m_max_delay_samples;
+    size_t                m_size;   // Taille du buffer circulaire
+    size_t                m_guard;  // Taille de la zone de garde (disposition Mirrored)
+    std::vector<T>        m_buffer;
+    size_t                m_writeIndex;
+    BufferLayout          m_layout;
+    size_t                m_mask;       // Taille du buffer - 1 (hors disposition Modulo)
+    SimdLevel             m_simdLevel;  // Jeu d'instructions des noyaux tap par tap
+    TapKernel<T>          m_tapKernel;  // Noyau tap par tap choisi selon m_simdLevel
+    ModulatedTapKernel<T> m_modulatedTapKernel;  // Idem, à gain variable (rampe de alpha)
+};
+
+/**
+ * Calcule les positions tk des 2K+2 taps (Equation 17), ramenées modulo la taille
+ * du buffer lu.
+ * @param tau1 Le premier délai (en échantillons).
+ * @param tau2 Le second délai (en échantillons).
+ * @param min_tau Le plus petit délai des taps principaux (voir SincTapReader::minTau).
+ * @param buffer_size La taille du buffer circulaire lu.
+ * @param positions Tableau de 2K+2 positions à remplir, dans [0, buffer_size].
+ */
+template <typename P>
+inline void sincTapPositions(int K, P tau1, P tau2, P min_tau, size_t buffer_size,
+                             P* positions)
+{
+    const int num_taps = 2 * K + 2;
+    const P   delta    = tau2 - tau1;
+    const P   size     = static_cast<P>(buffer_size);
+
+    for (int k = 0; k < num_taps; ++k) {
+        // Calculer la position du tap tk (Equation 17)
+        P tk = P(0);
+        if (k <= K) {
+            tk = tau1 - (static_cast<P>(K) - static_cast<P>(k)) * delta;
+        } else {
+            tk = tau2 + (static_cast<P>(k) - static_cast<P>(K) - P(1)) * delta;
+        }
+
+        // Taps principaux (tk = tau1 et tau2) : un tau2 ramené à delta entier peut
+        // passer sous le délai minimal de l'interpolateur
+        if ((k == K || k == K + 1) && tk < min_tau) {
+            tk = min_tau;
+        }
+
+        // Les taps auxiliaires peuvent sortir de [0, max_delay_samples) : ramener tk
+        // modulo la taille du buffer pour que la lecture n'ait qu'un wrap-around à gérer
+        tk = std::fmod(tk, size);
+        if (tk < P(0)) {
+            tk += size;
+        }
+        positions[k] = tk;
+    }
+}
+
+/**
+ * Paramètres et taps d'une lecture multi-tap sinc (tau1, tau2, alpha, K) dans un
+ * historique SincDelayBuffer. Un MultiTapSincDelay associe un lecteur à son propre
+ * buffer, un MultiReaderSincDelay partage un buffer entre plusieurs lecteurs.
+ * @param T Le type des échantillons (gains des taps).
+ * @param P Le type des paramètres (tau1, tau2, alpha et positions des taps).
+ * @param FIXED_K La valeur de K fixée à la compilation, ou -1 pour un K dynamique.
+ * @param INTERP La politique d'interpolation des lectures fractionnaires (voir
+ * MultiTapSincDelayInterpolators.h).
+ */
+template <typename T = double, typename P = double, int FIXED_K = -1,
+          typename INTERP = LinearInterpolator>
+class SincTapReader {
+   public:
+    /**
+     * Constructeur.
+     * @param max_delay_samples Délai maximal (en échantillons), borne de tau1 et tau2.
+     * @param initial_K Valeur initiale du paramètre K (nombre de paires de taps
+     * auxiliaires).
+     */
+    SincTapReader(size_t max_delay_samples, int initial_K = (FIXED_K >= 0 ? FIXED_K : 1))
+        : m_max_delay_samples(max_delay_samples),
+          m_pruneThreshold(T(0)),
+          m_numActive(0),
+          m_tapsRead(0),
+          m_tapsSkipped(0),
+          m_deltaSnapTolerance(P(0)),
+          m_integerDelta(false),
+          m_sharedFrac(T(0)),
+          m_rampActive(false),
+          m_rampDelay(0),
+          m_rampLength(0),
+          m_rampPos(0),
+          m_sinPiAlpha(0.0),
+          m_cosPiAlpha(1.0),
+          m_sinPiStep(0.0),
+          m_cosPiStep(1.0)
+    {
+        setK(initial_K);  // Utilise le setter pour valider K
+                          // Initialiser les délais à des valeurs par défaut sûres
+        setTau1(std::max(P(1), minTau()));
+        setTau2(m_tau1 + P(1));
+        setAlpha(0.0);
+    }
+
+    /**
+     * Définit le paramètre K (nombre de paires de taps auxiliaires).
+     * K=0 signifie 2 taps au total, K=1 signifie 4 taps, etc.
+     */
+    void setK(int newK)
+    {
+        if (newK < 0) {
+            MTSD_THROW(std::invalid_argument, "K cannot be negative.");
+        }
+        if (FIXED_K >= 0 && newK != FIXED_K) {
+            MTSD_THROW(std::invalid_argument, "K is fixed at compile time for this instance.");
+        }
+        reserveK(newK);
+        m_K = newK;
+        resizeTaps();
+        if (m_gainTable) {
+            m_gainTable = SincGainTable::get(getK(), m_gainTable->resolution());
+        }
+    }
+
+    /**
+     * Réserve la mémoire des taps jusqu'à max_K, pour que trySetK() n'alloue jamais.
+     */
+    void reserveK(int max_K)
+    {
+        if (max_K < 0) {
+            MTSD_THROW(std::invalid_argument, "K cannot be negative.");
+        }
+        const size_t num_taps = 2 * static_cast<size_t>(max_K) + 2;
+        m_tapDelays.reserve(num_taps);
+        m_tapGains.reserve(num_taps);
+        m_activeTaps.reserve(num_taps);
+        m_tapOffsets.reserve(num_taps);
+        m_tapPositions.reserve(num_taps);
+        m_rampGains.reserve(num_taps * SincDelayBuffer<T>::kMaxBlockSize);
+    }
+
+    /**
+     * Variante de setK() sans exception ni allocation, utilisable depuis le thread audio.
+     * @return InvalidK si K est négatif, différent de FIXED_K ou au-delà de la capacité
+     * réservée (voir reserveK), NotRealtimeSafe si une table de gains est utilisée
+     * (SincGainTable::get prend un verrou), Ok sinon.
+     */
+    SincDelayStatus trySetK(int newK) noexcept
+    {
+        if (newK < 0 || (FIXED_K >= 0 && newK != FIXED_K) ||
+            2 * static_cast<size_t>(newK) + 2 > m_tapDelays.capacity()) {
+            return SincDelayStatus::InvalidK;
+        }
+        if (newK == getK()) {
+            return SincDelayStatus::Ok;
+        }
+        if (m_gainTable) {
+            return SincDelayStatus::NotRealtimeSafe;
+        }
+        m_K = newK;
+        resizeTaps();  // Dans la capacité réservée : pas d'allocation
+        return SincDelayStatus::Ok;
+    }
+
+    /**
+     * Active la lecture des gains hk dans une table précalculée partagée
+     * (voir SincGainTable) au lieu de leur calcul exact.
+     * @param resolution Le nombre d'intervalles de la table, 0 pour revenir au calcul exact.
+     */
+    void useGainTable(size_t resolution = SincGainTable::kDefaultResolution)
+    {
+        m_gainTable = (resolution > 0) ? SincGainTable::get(getK(), resolution) : nullptr;
+    }
+
+    /**
+     * Retourne la table de gains utilisée, ou nullptr si les gains sont calculés exactement.
+     */
+    const SincGainTable* gainTable() const { return m_gainTable.get(); }
+
+    /**
+     * Retourne le paramètre K courant (constant si FIXED_K >= 0).
+     */
+    int getK() const { return (FIXED_K >= 0) ? FIXED_K : m_K; }
+
+    /**
+     * Retourne le nombre total de taps 2K+2 (constant si FIXED_K >= 0).
+     */
+    int numTaps() const { return 2 * getK() + 2; }
+
+    /**
+     * Définit le premier délai (tau1) en échantillons.
+     */
+    void setTau1(P newTau1)
+    {
+        if (trySetTau1(newTau1) != SincDelayStatus::Ok) {
+            MTSD_THROW(std::out_of_range, "Tau1 must be between minTau() and maxTau().");
+        }
+    }
+
+    /**
+     * Définit le second délai (tau2) en échantillons.
+     */
+    void setTau2(P newTau2)
+    {
+        if (trySetTau2(newTau2) != SincDelayStatus::Ok) {
+            MTSD_THROW(std::out_of_range, "Tau2 must be between minTau() and maxTau().");
+        }
+    }
+
+    /**
+     * Définit le facteur d'interpolation alpha (0=tau1, 1=tau2).
+     */
+    void setAlpha(P newAlpha)
+    {
+        if (trySetAlpha(newAlpha) != SincDelayStatus::Ok) {
+            MTSD_THROW(std::invalid_argument, "Alpha must be between 0.0 and 1.0.");
+        }
+    }
+
+    /**
+     * Variantes sans exception de setTau1(), setTau2() et setAlpha(). Une valeur hors
+     * limites est ignorée ou ramenée dans les limites selon policy.
+     */
+    SincDelayStatus trySetTau1(P newTau1, ParamPolicy policy = ParamPolicy::Reject) noexcept
+    {
+        SincDelayStatus status = checkRange(newTau1, minTau(), maxTau(), policy);
+        if (status != SincDelayStatus::OutOfRange) {
+            m_tau1 = newTau1;
+        }
+        return status;
+    }
+
+    SincDelayStatus trySetTau2(P newTau2, ParamPolicy policy = ParamPolicy::Reject) noexcept
+    {
+        SincDelayStatus status = checkRange(newTau2, minTau(), maxTau(), policy);
+        if (status != SincDelayStatus::OutOfRange) {
+            m_tau2 = newTau2;
+        }
+        return status;
+    }
+
+    SincDelayStatus trySetAlpha(P newAlpha, ParamPolicy policy = ParamPolicy::Reject) noexcept
+    {
+        SincDelayStatus status = checkRange(newAlpha, P(0), P(1), policy);
+        if (status != SincDelayStatus::OutOfRange) {
+            m_alpha      = newAlpha;
+            m_rampActive = false;  // Interrompt une rampe en cours
+        }
+        return status;
+    }
+
+    /**
+     * Programme une rampe linéaire de alpha, intégrée échantillon par échantillon par
+     * process() : alpha reste constant pendant start_offset échantillons, puis atteint
+     * target en duration échantillons. La rampe peut commencer et finir au milieu d'un
+     * bloc. Remplace une rampe en cours ; setAlpha() l'interrompt.
+     * @param target La valeur finale de alpha.
+     * @param duration La durée de la rampe en échantillons (0 pour un saut).
+     * @param start_offset Le nombre d'échantillons avant le début de la rampe.
+     */
+    void rampAlpha(P target, size_t duration, size_t start_offset = 0)
+    {
+        if (tryRampAlpha(target, duration, start_offset) != SincDelayStatus::Ok) {
+            MTSD_THROW(std::invalid_argument, "Alpha must be between 0.0 and 1.0.");
+        }
+    }
+
+    /**
+     * Variante sans exception de rampAlpha().
+     */
+    SincDelayStatus tryRampAlpha(P target, size_t duration, size_t start_offset = 0,
+                                 ParamPolicy policy = ParamPolicy::Reject) noexcept
+    {
+        SincDelayStatus status = checkRange(target, P(0), P(1), policy);
+        if (status == SincDelayStatus::OutOfRange) {
+            return status;
+        }
+        if (duration == 0 && start_offset == 0) {
+            m_alpha      = target;
+            m_rampActive = false;
+            return status;
+        }
+        m_rampActive = true;
+        m_rampStart  = m_alpha;
+        m_rampTarget = target;
+        m_rampStep   = (duration > 0) ? (target - m_alpha) / static_cast<P>(duration) : P(0);
+        m_rampDelay  = start_offset;
+        m_rampLength = duration;
+        m_rampPos    = 0;
+        m_sinPiStep  = std::sin(M_PI * static_cast<double>(m_rampStep));
+        m_cosPiStep  = std::cos(M_PI * static_cast<double>(m_rampStep));
+        return status;
+    }
+
+    /**
+     * Programme un segment de rampe : alpha passe à start, puis atteint end en
+     * length échantillons (voir rampAlpha).
+     */
+    void setAlphaSegment(P start, P end, size_t length)
+    {
+        setAlpha(start);
+        rampAlpha(end, length);
+    }
+
+    /**
+     * Indique si une rampe de alpha est programmée ou en cours.
+     */
+    bool isRamping() const { return m_rampActive; }
+
+    P tau1() const { return m_tau1; }
+    P tau2() const { return m_tau2; }
+    P alpha() const { return m_alpha; }
+
+    /**
+     * Plus petit délai accepté : les INTERP::kPoints - 1 - INTERP::kOrigin points lus
+     * après la position ne doivent pas dépasser l'échantillon qui vient d'être écrit,
+     * soit ceil(tau) >= kPoints - 1 - kOrigin. Au délai minTau() lui-même (entier), le
+     * point suivant est lu avec un poids nul. Vaut 0 en interpolation linéaire.
+     */
+    P minTau() const noexcept { return P(INTERP::kPoints - 2 - INTERP::kOrigin); }
+
+    /**
+     * Plus grand délai accepté : strictement inférieur à max_delay_samples - 1, une
+     * marge étant gardée pour l'interpolation. Les points lus avant la position
+     * (INTERP::kOrigin) réduisent d'autant la plage, pour ne jamais lire
+     * l'échantillon qui vient d'être écrit.
+     */
+    P maxTau() const noexcept
+    {
+        return std::nextafter(static_cast<P>(m_max_delay_samples) - P(1 + INTERP::kOrigin),
+                              P(0));
+    }
+
+    /**
+     * Indique si tau1 et tau2 sont (presque) égaux : cas du délai fixe.
+     */
+    bool isFixed() const
+    {
+        // Utiliser une petite tolérance pour comparer les flottants
+        const P epsilon = std::numeric_limits<P>::epsilon() * 100;
+        return std::abs(m_tau2 - m_tau1) < epsilon;
+    }
+
+    /**
+     * Indique si la sortie se réduit à un seul tap de gain unitaire : délai fixe, ou
+     * alpha exactement à 0 ou 1 hors rampe, où sinc(entier) annule tous les autres gains.
+     */
+    bool isSingleTap() const
+    {
+        return isFixed() || (!m_rampActive && m_pruneThreshold >= T(0) &&
+                             (m_alpha == P(0) || m_alpha == P(1)));
+    }
+
+    /**
+     * Retourne le délai du tap unique (voir isSingleTap) : tau2 si alpha vaut 1,
+     * tau1 sinon.
+     */
+    P singleTapDelay() const { return (m_alpha == P(1) && !isFixed()) ? m_tau2 : m_tau1; }
+
+    /**
+     * Définit le seuil d'élagage : hors rampe, les taps de gain |hk| <= threshold ne
+     * sont pas lus. Le seuil par défaut (0) n'élague que les gains exactement nuls ;
+     * un seuil négatif désactive l'élagage et la lecture unique de alpha entier.
+     */
+    void setPruneThreshold(T threshold) { m_pruneThreshold = threshold; }
+    T    pruneThreshold() const { return m_pruneThreshold; }
+
+    /**
+     * Retourne le nombre de lectures de taps effectuées et évitées (tap unique ou
+     * élagage) depuis le dernier resetTapCounters(), un tap lu sur un échantillon
+     * comptant pour une lecture.
+     */
+    uint64_t tapsRead() const { return m_tapsRead; }
+    uint64_t tapsSkipped() const { return m_tapsSkipped; }
+
+    void resetTapCounters()
+    {
+        m_tapsRead    = 0;
+        m_tapsSkipped = 0;
+    }
+
+    /**
+     * Définit la tolérance de delta entier : si |delta - round(delta)| <= tolerance,
+     * les taps sont placés avec delta = round(delta) (tau2 ramené à tau1 + round(delta)),
+     * et partagent alors tous la partie fractionnaire de tau1. Les lectures utilisent
+     * un noyau qui somme les taps à délais entiers puis interpole une seule fois.
+     * Par défaut (0), seuls les delta exactement entiers prennent ce chemin.
+     * @param tolerance La tolérance, dans [0, 0.5).
+     */
+    void setDeltaSnapTolerance(P tolerance)
+    {
+        if (!(tolerance >= P(0) && tolerance < P(0.5))) {
+            MTSD_THROW(std::invalid_argument, "Delta snap tolerance must be between 0.0 and 0.5.");
+        }
+        m_deltaSnapTolerance = tolerance;
+    }
+
+    P deltaSnapTolerance() const { return m_deltaSnapTolerance; }
+
+    /**
+     * Indique si le dernier updateTaps() a retenu un delta entier (voir
+     * setDeltaSnapTolerance).
+     */
+    bool isIntegerDelta() const { return m_integerDelta; }
+
+    /**
+     * Compte les lectures de taps d'un bloc de count échantillons.
+     * @param single_tap La valeur de isSingleTap() pour le bloc.
+     */
+    void countTaps(bool single_tap, size_t count)
+    {
+        const uint64_t read = single_tap ? 1 : static_cast<uint64_t>(m_numActive);
+        m_tapsRead += read * count;
+        m_tapsSkipped += (static_cast<uint64_t>(numTaps()) - read) * count;
+    }
+
+    /**
+     * Calcule les positions tk et les gains hk des 2K+2 taps pour les paramètres
+     * courants (Equations 17 et 19), dans le cas variable (!isFixed()).
+     * @param buffer_size La taille du buffer circulaire lu, modulo laquelle les
+     * positions sont ramenées.
+     */
+    void updateTaps(size_t buffer_size)
+    {
+        const int K = getK();
+
+        // delta entier, ou ramené à l'entier le plus proche dans la tolérance : toutes
+        // les positions ont la partie fractionnaire de tau1
+        const P delta   = m_tau2 - m_tau1;
+        const P rounded = std::round(delta);
+        m_integerDelta  = rounded != P(0) && std::abs(delta - rounded) <= m_deltaSnapTolerance;
+        const P tau2    = m_integerDelta ? m_tau1 + rounded : m_tau2;
+        sincTapPositions(K, m_tau1, tau2, minTau(), buffer_size, m_tapDelays.data());
+
+        // Positions relatives en virgule fixe 32.32 (voir SincDelayBuffer::readFixed)
+        const P size = static_cast<P>(buffer_size);
+        for (int k = 0; k < numTaps(); ++k) {
+            m_tapPositions[k] = toFixedPosition(size - m_tapDelays[k]);
+        }
+        if (m_integerDelta) {
+            updateTapOffsets(buffer_size);
+        }
+
+        // Phaseur de la rampe recalé une fois par bloc pour borner la dérive
+        if (m_rampActive) {
+            anchorPhasor();
+        }
+
+        // Calculer les gains des taps hk (Equation 19), exacts ou lus dans la table
+        if (m_gainTable) {
+            m_gainTable->gains(static_cast<double>(m_alpha), m_tapGains.data());
+        } else {
+            sincGains(K, static_cast<double>(m_alpha), m_tapGains.data());
+        }
+
+        // Taps lus sur le bloc : tous pendant une rampe (gains recalculés par
+        // échantillon), sinon ceux dont le gain dépasse le seuil d'élagage
+        const int num_taps = numTaps();
+        m_numActive        = 0;
+        for (int k = 0; k < num_taps; ++k) {
+            if (m_rampActive || std::abs(m_tapGains[k]) > m_pruneThreshold) {
+                m_activeTaps[static_cast<size_t>(m_numActive++)] = k;
+            }
+        }
+    }
+
+    /**
+     * Recalcule les gains hk pour le alpha de l'échantillon courant d'une rampe, à
+     * partir du phaseur (sans appel à std::sin).
+     */
+    void updateRampGains() { currentGains(m_tapGains.data()); }
+
+    /**
+     * Avance la rampe de alpha d'un échantillon. Pendant la rampe, sin(pi*alpha) est
+     * tourné par le phaseur (sin, cos)(pi*pas) au lieu d'être recalculé.
+     */
+    void advanceAlpha()
+    {
+        if (!m_rampActive) {
+            return;
+        }
+        if (m_rampDelay > 0) {
+            --m_rampDelay;
+            if (m_rampDelay == 0 && m_rampLength == 0) {
+                finishRamp();
+            }
+            return;
+        }
+        if (++m_rampPos >= m_rampLength) {
+            finishRamp();
+            return;
+        }
+        m_alpha       = m_rampStart + static_cast<P>(m_rampPos) * m_rampStep;
+        double sin_pi = m_sinPiAlpha * m_cosPiStep + m_cosPiAlpha * m_sinPiStep;
+        m_cosPiAlpha  = m_cosPiAlpha * m_cosPiStep - m_sinPiAlpha * m_sinPiStep;
+        m_sinPiAlpha  = sin_pi;
+    }
+
+    /**
+     * Avance la rampe de alpha de count échantillons d'un coup (délai fixe, où les
+     * gains ne servent pas).
+     */
+    void skipAlpha(size_t count)
+    {
+        while (count > 0 && m_rampActive) {
+            if (m_rampDelay > 0) {
+                size_t steps = std::min(count, m_rampDelay);
+                m_rampDelay -= steps;
+                count -= steps;
+                if (m_rampDelay == 0 && m_rampLength == 0) {
+                    finishRamp();
+                }
+                continue;
+            }
+            size_t steps = std::min(count, m_rampLength - m_rampPos);
+            m_rampPos += steps;
+            count -= steps;
+            if (m_rampPos >= m_rampLength) {
+                finishRamp();
+            } else {
+                m_alpha = m_rampStart + static_cast<P>(m_rampPos) * m_rampStep;
+                anchorPhasor();
+            }
+        }
+    }
+
+    /**
+     * Retourne les positions tk calculées par updateTaps(), modulo la taille du buffer.
+     */
+    const P* tapDelays() const { return m_tapDelays.data(); }
+
+    /**
+     * Retourne les gains hk calculés par updateTaps().
+     */
+    const T* tapGains() const { return m_tapGains.data(); }
+
+    /**
+     * Lit un échantillon de sortie au fil de l'eau (dispositions Modulo et PowerOfTwo),
+     * l'échantillon courant étant déjà écrit dans le buffer.
+     * @param single_tap La valeur de isSingleTap() pour le bloc courant.
+     */
+    template <BufferLayout LAYOUT>
+    T read(const SincDelayBuffer<T>& buffer, bool single_tap) const
+    {
+        // Cas spécial : délai fixe ou alpha à une extrémité, un seul tap de gain unitaire
+        if (single_tap) {
+            return buffer.template readFixed<LAYOUT, INTERP>(buffer.fixedOffset(singleTapDelay()));
+        }
+
+        // delta entier : une seule interpolation pour tous les taps
+        if (m_integerDelta) {
+            return buffer.template readIntegerTaps<LAYOUT, INTERP>(
+                m_tapOffsets.data(), m_tapGains.data(), m_activeTaps.data(), m_numActive,
+                m_sharedFrac);
+        }
+
+        // Cas général : somme des taps, positions et gains calculés par updateTaps()
+        const int num_taps  = numTaps();
+        T         outputSum = T(0);
+        if (m_numActive < num_taps) {
+            // Taps élagués : seuls les taps actifs sont lus
+            for (int a = 0; a < m_numActive; ++a) {
+                int k = m_activeTaps[static_cast<size_t>(a)];
+                outputSum +=
+                    buffer.template readFixed<LAYOUT, INTERP>(m_tapPositions[k]) * m_tapGains[k];
+            }
+            return outputSum;
+        }
+        for (int k = 0; k < num_taps; ++k) {
+            // Lire la valeur interpolée du buffer (position en virgule fixe) et l'ajouter
+            outputSum +=
+                buffer.template readFixed<LAYOUT, INTERP>(m_tapPositions[k]) * m_tapGains[k];
+        }
+        return outputSum;
+    }
+
+    /**
+     * Ajoute à acc la sortie d'un sous-bloc déjà écrit, tap par tap (disposition Mirrored).
+     * Comme tau1 et tau2 sont constants sur le bloc, la position de lecture d'un tap
+     * avance d'un échantillon par trame et sa partie fractionnaire reste constante :
+     * chaque tap lit une plage contiguë du buffer (grâce à la zone de garde) avec des
+     * poids d'interpolation fixes, une boucle vectorisable.
+     * Pendant une rampe de alpha, les gains varient à chaque échantillon : ils sont
+     * calculés pour tout le sous-bloc puis appliqués par le noyau à gain variable.
+     * @param writeIndex L'index d'écriture du premier échantillon du sous-bloc.
+     * @param single_tap La valeur de isSingleTap() pour le bloc courant.
+     * @param ramp La valeur de isRamping() au début du bloc courant.
+     * @param count Le nombre d'échantillons du sous-bloc (au plus kMaxBlockSize).
+     */
+    void accumulate(const SincDelayBuffer<T>& buffer, size_t writeIndex, bool single_tap,
+                    bool ramp, T* acc, size_t count)
+    {
+        countTaps(single_tap, count);
+        if (single_tap) {
+            // Délai fixe ou alpha à une extrémité : un seul tap de gain unitaire
+            buffer.template accumulateTap<INTERP>(acc, writeIndex, singleTapDelay(), T(1), count);
+            if (ramp) {
+                skipAlpha(count);
+            }
+            return;
+        }
+        const int num_taps = numTaps();
+        if (ramp) {
+            // Gains du sous-bloc rangés tap par tap : m_rampGains[k * count + i]
+            for (size_t i = 0; i < count; ++i) {
+                currentGains(m_tapGains.data());
+                for (int k = 0; k < num_taps; ++k) {
+                    m_rampGains[static_cast<size_t>(k) * count + i] = m_tapGains[k];
+                }
+                advanceAlpha();
+            }
+            for (int k = 0; k < num_taps; ++k) {
+                buffer.template accumulateTapModulatedFixed<INTERP>(
+                    acc, writeIndex, m_tapPositions[k],
+                    &m_rampGains[static_cast<size_t>(k) * count], count);
+            }
+            return;
+        }
+        // Hors rampe, seuls les taps actifs (non élagués) sont lus
+        if (m_integerDelta) {
+            buffer.template accumulateIntegerTaps<INTERP>(acc, writeIndex, m_tapOffsets.data(),
+                                                          m_tapGains.data(), m_activeTaps.data(),
+                                                          m_numActive, m_sharedFrac, count);
+            return;
+        }
+        for (int a = 0; a < m_numActive; ++a) {
+            int k = m_activeTaps[static_cast<size_t>(a)];
+            buffer.template accumulateTapFixed<INTERP>(acc, writeIndex, m_tapPositions[k],
+                                                       m_tapGains[k], count);
+        }
+    }
+
+   private:
+    /**
+     * Calcule les décalages entiers des taps et leur partie fractionnaire commune
+     * (delta entier, voir readIntegerTaps), une fois par bloc.
+     */
+    void updateTapOffsets(size_t buffer_size)
+    {
+        const uint64_t frac = m_tapPositions[static_cast<size_t>(getK())] & kFixedFracMask;
+        m_sharedFrac        = static_cast<T>(frac) * T(1.0 / kFixedOne);
+        // Un tour de buffer est ajouté avant de retirer frac : une position proche de zéro
+        // dont la partie fractionnaire arrondie dépasse frac ne passe pas sous zéro
+        const uint64_t wrap =
+            (static_cast<uint64_t>(buffer_size) << kFixedFracBits) + kFixedOne / 2;
+        for (int k = 0; k < numTaps(); ++k) {
+            // Positions de même partie fractionnaire aux arrondis près : arrondir, puis
+            // ramener dans [0, taille du buffer) pour qu'une soustraction suffise à la lecture
+            uint64_t base   = (m_tapPositions[k] + wrap - frac) >> kFixedFracBits;
+            m_tapOffsets[k] = (static_cast<size_t>(base) - INTERP::kOrigin) % buffer_size;
+        }
+    }
+
+    void resizeTaps()
+    {
+        m_tapDelays.resize(static_cast<size_t>(numTaps()));
+        m_tapGains.resize(static_cast<size_t>(numTaps()));
+        m_activeTaps.resize(static_cast<size_t>(numTaps()));
+        m_tapOffsets.resize(static_cast<size_t>(numTaps()));
+        m_tapPositions.resize(static_cast<size_t>(numTaps()));
+        m_numActive = numTaps();
+        m_rampGains.resize(static_cast<size_t>(numTaps()) * SincDelayBuffer<T>::kMaxBlockSize);
+    }
+
+    /**
+     * Calcule les gains hk pour le alpha courant, à partir du phaseur ou de la table.
+     */
+    void currentGains(T* gains) const
+    {
+        if (m_gainTable) {
+            m_gainTable->gains(static_cast<double>(m_alpha), gains);
+        } else {
+            sincGains(getK(), static_cast<double>(m_alpha), m_sinPiAlpha, gains);
+        }
+    }
+
+    void anchorPhasor()
+    {
+        m_sinPiAlpha = std::sin(M_PI * static_cast<double>(m_alpha));
+        m_cosPiAlpha = std::cos(M_PI * static_cast<double>(m_alpha));
+    }
+
+    void finishRamp()
+    {
+        m_alpha      = m_rampTarget;
+        m_rampActive = false;
+        anchorPhasor();
+    }
+
+    size_t         m_max_delay_samples;
+    int            m_K;  // Valeur dynamique de K (égale à FIXED_K si celui-ci est fixé)
+    P              m_tau1;
+    P              m_tau2;
+    P              m_alpha;
+    std::vector<P> m_tapDelays;  // Positions tk des taps modulo la taille du buffer
+    std::vector<T> m_tapGains;   // Gains hk des taps (recalculés par bloc)
+    std::shared_ptr<const SincGainTable> m_gainTable;  // Table de gains partagée (optionnelle)
+
+    // Élagage des taps (voir setPruneThreshold)
+    T                m_pruneThreshold;
+    std::vector<int> m_activeTaps;  // Index des taps lus sur le bloc courant
+    int              m_numActive;
+    uint64_t         m_tapsRead;
+    uint64_t         m_tapsSkipped;
+
+    // delta entier (voir setDeltaSnapTolerance)
+    P                   m_deltaSnapTolerance;
+    bool                m_integerDelta;
+    T                   m_sharedFrac;  // Partie fractionnaire commune des taps
+    std::vector<size_t> m_tapOffsets;  // Décalages entiers des taps (voir readIntegerTaps)
+
+    // Positions des taps en virgule fixe 32.32, relatives à l'index d'écriture
+    std::vector<uint64_t> m_tapPositions;
+
+    // Rampe de alpha (voir rampAlpha)
+    bool           m_rampActive;
+    P              m_rampStart;
+    P              m_rampTarget;
+    P              m_rampStep;    // Incrément de alpha par échantillon
+    size_t         m_rampDelay;   // Échantillons restant avant le début de la rampe
+    size_t         m_rampLength;
+    size_t         m_rampPos;     // Échantillons écoulés depuis le début de la rampe
+    double         m_sinPiAlpha;  // Phaseur (sin, cos)(pi * alpha)
+    double         m_cosPiAlpha;
+    double         m_sinPiStep;  // Rotation (sin, cos)(pi * m_rampStep)
+    double         m_cosPiStep;
+    std::vector<T> m_rampGains;  // Gains d'un sous-bloc pendant une rampe, tap par tap
+};
+
+/**
+ * Ligne à retard variable par interpolation sinc multi-tap.
+ * @param T Le type des échantillons (buffer, entrées et sorties, gains des taps).
+ * @param P Le type des paramètres (tau1, tau2, alpha et positions des taps) : garder
+ * P = double avec T = float conserve la précision des positions dans les grands buffers
+ * tout en divisant par deux la mémoire et la bande passante des échantillons.
+ * @param FIXED_K La valeur de K fixée à la compilation, ou -1 pour un K choisi à
+ * l'exécution (setK). Avec K fixé, le nombre de taps, leurs décalages (k - K) et le
+ * signe de leurs gains sont des constantes : les boucles sur les taps se déroulent.
+ * Voir aussi MultiTapSincDelayK et makeMultiTapSincDelay().
+ * @param INTERP La politique d'interpolation des lectures fractionnaires : linéaire
+ * par défaut, Lagrange, Hermite ou Farrow (voir MultiTapSincDelayInterpolators.h).
+ * Un interpolateur plus précis peut remplacer une partie des taps auxiliaires.
+ */
+template <typename T = double, typename P = double, int FIXED_K = -1,
+          typename INTERP = LinearInterpolator>
+class MultiTapSincDelay {
+   public:
+    static constexpr size_t kMaxBlockSize = SincDelayBuffer<T>::kMaxBlockSize;
+    static constexpr size_t kMaxTapSpan   = SincDelayBuffer<T>::kMaxTapSpan;
+
+    /**
+     * Constructeur.
+     * @param max_delay_samples Taille maximale du buffer de délai en
+     * échantillons.
+     * @param initial_K Valeur initiale du paramètre K (nombre de paires de taps
+     * auxiliaires).
+     * @param layout Disposition mémoire du buffer (voir BufferLayout). Les limites
+     * de délai restent fixées par max_delay_samples quelle que soit la disposition.
+     */
+    MultiTapSincDelay(size_t max_delay_samples, int initial_K = (FIXED_K >= 0 ? FIXED_K : 1),
+                      P sample_rate = 44100.0, BufferLayout layout = BufferLayout::Modulo)
+        : m_buffer(max_delay_samples, layout),
+          m_reader(max_delay_samples, initial_K),
+          m_sampleRate(sample_rate)
+    {
+    }
+
+    /**
+     * Définit le paramètre K (nombre de paires de taps auxiliaires).
+     * K=0 signifie 2 taps au total, K=1 signifie 4 taps, etc.
+     */
+    void setK(int newK) { m_reader.setK(newK); }
+
+    /**
+     * Réserve la mémoire des taps jusqu'à max_K (voir trySetK).
+     */
+    void reserveK(int max_K) { m_reader.reserveK(max_K); }
+
+    /**
+     * Variante de setK() sans exception ni allocation (voir SincTapReader::trySetK).
+     */
+    SincDelayStatus trySetK(int newK) noexcept { return m_reader.trySetK(newK); }
+
+    /**
+     * Active la lecture des gains hk dans une table précalculée partagée
+     * (voir SincGainTable) au lieu de leur calcul exact.
+     * @param resolution Le nombre d'intervalles de la table, 0 pour revenir au calcul exact.
+     */
+    void useGainTable(size_t resolution = SincGainTable::kDefaultResolution)
+    {
+        m_reader.useGainTable(resolution);
+    }
+
+    /**
+     * Retourne la table de gains utilisée, ou nullptr si les gains sont calculés exactement.
+     */
+    const SincGainTable* gainTable() const { return m_reader.gainTable(); }
+
+    /**
+     * Retourne le paramètre K courant (constant si FIXED_K >= 0).
+     */
+    int getK() const { return m_reader.getK(); }
+
+    /**
+     * Retourne le nombre total de taps 2K+2 (constant si FIXED_K >= 0).
+     */
+    int numTaps() const { return m_reader.numTaps(); }
+
+    /**
+     * Définit le premier délai (tau1) en échantillons.
+     */
+    void setTau1(P newTau1) { m_reader.setTau1(newTau1); }
+
+    /**
+     * Définit le second délai (tau2) en échantillons.
+     */
+    void setTau2(P newTau2) { m_reader.setTau2(newTau2); }
+
+    /**
+     * Définit le facteur d'interpolation alpha (0=tau1, 1=tau2).
+     */
+    void setAlpha(P newAlpha) { m_reader.setAlpha(newAlpha); }
+
+    /**
+     * Variantes sans exception des setters, utilisables depuis le thread audio : une
+     * valeur hors limites est ignorée (ParamPolicy::Reject) ou ramenée dans les
+     * limites (ParamPolicy::Clamp), et le résultat est renvoyé en SincDelayStatus.
+     */
+    SincDelayStatus trySetTau1(P newTau1, ParamPolicy policy = ParamPolicy::Reject) noexcept
+    {
+        return m_reader.trySetTau1(newTau1, policy);
+    }
+
+    SincDelayStatus trySetTau2(P newTau2, ParamPolicy policy = ParamPolicy::Reject) noexcept
+    {
+        return m_reader.trySetTau2(newTau2, policy);
+    }
+
+    SincDelayStatus trySetAlpha(P newAlpha, ParamPolicy policy = ParamPolicy::Reject) noexcept
+    {
+        return m_reader.trySetAlpha(newAlpha, policy);
+    }
+
+    SincDelayStatus tryRampAlpha(P target, size_t duration, size_t start_offset = 0,
+                                 ParamPolicy policy = ParamPolicy::Reject) noexcept
+    {
+        return m_reader.tryRampAlpha(target, duration, start_offset, policy);
+    }
+
+    /**
+     * Programme une rampe linéaire de alpha vers target en duration échantillons,
+     * après start_offset échantillons (voir SincTapReader::rampAlpha).
+     */
+    void rampAlpha(P target, size_t duration, size_t start_offset = 0)
+    {
+        m_reader.rampAlpha(target, duration, start_offset);
+    }
+
+    /**
+     * Programme un segment de rampe de alpha (start, end, length).
+     */
+    void setAlphaSegment(P start, P end, size_t length)
+    {
+        m_reader.setAlphaSegment(start, end, length);
+    }
+
+    /**
+     * Indique si une rampe de alpha est programmée ou en cours.
+     */
+    bool isRamping() const { return m_reader.isRamping(); }
+
+    /**
+     * Retourne le alpha courant (celui du prochain échantillon pendant une rampe).
+     */
+    P getAlpha() const { return m_reader.alpha(); }
+
+    /**
+     * Retourne les bornes de tau1 et tau2, qui dépendent de l'interpolateur (voir
+     * SincTapReader::minTau et SincTapReader::maxTau).
+     */
+    P minTau() const { return m_reader.minTau(); }
+    P maxTau() const { return m_reader.maxTau(); }
+
+    /**
+     * Définit le seuil d'élagage des taps (voir SincTapReader::setPruneThreshold) : hors
+     * rampe, les taps de gain |hk| <= threshold ne sont pas lus. Par défaut (0), seuls
+     * les gains nuls sont élagués, et alpha à 0 ou 1 se réduit à une lecture unique.
+     */
+    void setPruneThreshold(T threshold) { m_reader.setPruneThreshold(threshold); }
+    T    getPruneThreshold() const { return m_reader.pruneThreshold(); }
+
+    /**
+     * Définit la tolérance de delta entier (voir SincTapReader::setDeltaSnapTolerance) :
+     * un delta entier, ou ramené à l'entier dans la tolérance, donne à tous les taps la
+     * même partie fractionnaire et une seule interpolation par échantillon.
+     */
+    void setDeltaSnapTolerance(P tolerance) { m_reader.setDeltaSnapTolerance(tolerance); }
+    P    getDeltaSnapTolerance() const { return m_reader.deltaSnapTolerance(); }
+
+    /**
+     * Retourne le nombre de lectures de taps effectuées et évitées depuis le dernier
+     * resetTapCounters().
+     */
+    uint64_t tapsRead() const { return m_reader.tapsRead(); }
+    uint64_t tapsSkipped() const { return m_reader.tapsSkipped(); }
+    void     resetTapCounters() { m_reader.resetTapCounters(); }
+
+    /**
+     * Traite un échantillon audio.
+     * @param inputSample L'échantillon d'entrée.
+     * @return L'échantillon de sortie traité.
+     */
+    T process(T inputSample) noexcept
+    {
+        T output = T(0);
+        process(&inputSample, &output, 1);
+        return output;
+    }
+
+    /**
+     * Traite un bloc d'échantillons audio.
+     * Les paramètres (tau1, tau2, alpha, K) sont constants sur le bloc : delta, tau,
+     * positions et gains des taps sont calculés une seule fois avant la boucle.
+     * Le traitement en place (in == out) est supporté.
+     * @param in Le bloc d'entrée.
+     * @param out Le bloc de sortie (peut être égal à in).
+     * @param n Le nombre d'échantillons du bloc.
+     */
+    void process(const T* in, T* out, size_t n) noexcept
+    {
+        switch (m_buffer.layout()) {
+            case BufferLayout::Modulo:
+                processBlock<BufferLayout::Modulo>(in, out, n);
+                break;
+            case BufferLayout::PowerOfTwo:
+                processBlock<BufferLayout::PowerOfTwo>(in, out, n);
+                break;
+            case BufferLayout::Mirrored:
+                processTapMajor(in, out, n);
+                break;
+        }
+    }
+
+    /**
+     * Retourne la disposition mémoire du buffer de délai.
+     */
+    BufferLayout layout() const { return m_buffer.layout(); }
+
+    /**
+     * Retourne la taille du buffer circulaire (en échantillons), supérieure ou
+     * égale à max_delay_samples, hors zone de garde.
+     */
+    size_t bufferSize() const { return m_buffer.size(); }
+
+    /**
+     * Retourne la taille de la zone de garde (en échantillons), 0 hors disposition Mirrored.
+     * Elle est bornée par kMaxTapSpan, l'étendue maximale d'une lecture contiguë.
+     */
+    size_t guardSize() const { return m_buffer.guardSize(); }
+
+    /**
+     * Retourne le surcoût mémoire du buffer (en octets) par rapport à
+     * max_delay_samples échantillons : arrondi à une puissance de deux et zone de garde.
+     */
+    size_t memoryOverhead() const { return m_buffer.memoryOverhead(); }
+
+    /**
+     * Force le jeu d'instructions des noyaux tap par tap (disposition Mirrored).
+     * Par défaut, le plus large supporté par le CPU est choisi à la construction ;
+     * un jeu non supporté est remplacé par le noyau scalaire.
+     */
+    void setSimdLevel(SimdLevel level) { m_buffer.setSimdLevel(level); }
+
+    /**
+     * Retourne le jeu d'instructions utilisé par les noyaux tap par tap.
+     */
+    SimdLevel simdLevel() const { return m_buffer.simdLevel(); }
+
+   private:
+    /**
+     * Traitement par blocs d'un délai fixe (un seul tap de gain unitaire, voir
+     * SincTapReader::isSingleTap) : chaque sous-bloc est écrit dans le buffer puis lu
+     * d'un coup, par copie si le délai est entier, sinon par un filtre à coefficients
+     * constants (SincDelayBuffer::readFractionalBlock).
+     * Hors disposition Mirrored, les sous-blocs sont limités pour ne pas écraser
+     * l'historique encore lu. Le délai n'est jamais inférieur à SincTapReader::minTau :
+     * les points lus après la position s'arrêtent à l'échantillon courant du sous-bloc.
+     */
+    template <BufferLayout LAYOUT>
+    void processSingleTap(const T* in, T* out, size_t n) noexcept
+    {
+        const P      tau     = m_reader.singleTapDelay();
+        const P      whole   = std::floor(tau);
+        const bool   integer = tau == whole;
+        const size_t delay   = static_cast<size_t>(whole);
+
+        // Plus ancien échantillon lu : delay, ou ceil(tau) + kOrigin si le délai est
+        // fractionnaire
+        size_t max_count = kMaxBlockSize;
+        if (LAYOUT != BufferLayout::Mirrored) {
+            const size_t reach = integer ? delay : delay + 1 + INTERP::kOrigin;
+            max_count          = std::min(max_count, m_buffer.size() - reach);
+        }
+
+        if (m_reader.isRamping()) {
+            m_reader.skipAlpha(n);
+        }
+        m_reader.countTaps(true, n);
+        for (size_t start = 0; start < n; start += max_count) {
+            size_t count = std::min(max_count, n - start);
+
+            // Écrire tout le sous-bloc avant de produire la sortie (traitement en place)
+            size_t writeIndex = m_buffer.writeBlock(in + start, count);
+            if (integer) {
+                m_buffer.readBlock(out + start, writeIndex, delay, count);
+            } else {
+                m_buffer.template readFractionalBlock<INTERP>(out + start, writeIndex, tau, count);
+            }
+        }
+    }
+
+    /**
+     * Boucle de traitement d'un bloc, spécialisée selon la disposition du buffer.
+     */
+    template <BufferLayout LAYOUT>
+    void processBlock(const T* in, T* out, size_t n) noexcept
+    {
+        if (m_reader.isSingleTap()) {
+            processSingleTap<LAYOUT>(in, out, n);
+            return;
+        }
+
+        // Positions et gains des taps calculés une fois par bloc
+        const bool ramp = m_reader.isRamping();
+        m_reader.updateTaps(m_buffer.size());
+        m_reader.countTaps(false, n);
+
+        for (size_t i = 0; i < n; ++i) {
+            // Pendant une rampe, gains recalculés à chaque échantillon
+            if (ramp) {
+                m_reader.updateRampGains();
+            }
+
+            // Lire l'entrée avant d'écrire la sortie (traitement en place)
+            m_buffer.template writeSample<LAYOUT>(in[i]);
+            out[i] = m_reader.template read<LAYOUT>(m_buffer, false);
+            if (ramp) {
+                m_reader.advanceAlpha();
+            }
+
+            // Incrémenter l'index d'écriture (avec wrap-around)
+            m_buffer.template advance<LAYOUT>();
+        }
+    }
+
+    /**
+     * Traitement d'un bloc tap par tap (disposition Mirrored), par sous-blocs d'au
+     * plus kMaxBlockSize échantillons écrits dans le buffer avant d'être lus
+     * (voir SincTapReader::accumulate).
+     */
+    void processTapMajor(const T* in, T* out, size_t n) noexcept
+    {
+        if (m_reader.isSingleTap()) {
+            processSingleTap<BufferLayout::Mirrored>(in, out, n);
+            return;
+        }
+
+        const bool ramp = m_reader.isRamping();
+        m_reader.updateTaps(m_buffer.size());
+
+        T acc[kMaxBlockSize];
+        for (size_t start = 0; start < n; start += kMaxBlockSize) {
+            size_t count = std::min(kMaxBlockSize, n - start);
+
+            // Écrire tout le sous-bloc avant de produire la sortie (traitement en place)
+            size_t writeIndex = m_buffer.writeBlock(in + start, count);
+
+            std::fill(acc, acc + count, T(0));
+            m_reader.accumulate(m_buffer, writeIndex, false, ramp, acc, count);
+            std::copy(acc, acc + count, out + start);
+        }
+    }
+
+    // Membres de la classe
+    SincDelayBuffer<T>                   m_buffer;
+    SincTapReader<T, P, FIXED_K, INTERP> m_reader;
+    P                                    m_sampleRate;
+};
+
+/**
+ * MultiTapSincDelay avec K fixé à la compilation (boucles sur les taps déroulées).
+ */
+template <int K, typename T = double, typename P = double, typename INTERP = LinearInterpolator>
+using MultiTapSincDelayK = MultiTapSincDelay<T, P, K, INTERP>;
+
+#endif  // MULTI_TAP_SINC_DELAY_H
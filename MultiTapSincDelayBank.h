@@ -0,0 +1,343 @@
+/************************************************************************
+ Banque de 8 ou 16 lignes MultiTapSincDelay vectorisée à travers les lignes :
+ une voie SIMD par ligne, historiques entrelacés et lectures par gather.
+ ************************************************************************/
+
+#ifndef MULTI_TAP_SINC_DELAY_BANK_H
+#define MULTI_TAP_SINC_DELAY_BANK_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "MultiTapSincDelay.h"
+
+/**
+ * Banque de LANES lignes à retard (8 ou 16), chacune avec sa propre entrée et ses
+ * propres tau1, tau2 et alpha, K étant commun à la banque. Avec un K petit (K = 0 ou 1,
+ * 2 à 4 taps), vectoriser sur les taps laisse des voies SIMD inoccupées : ici chaque
+ * voie traite une ligne.
+ *
+ * Les paramètres sont stockés en structure de tableaux (m_tau1[], m_tau2[], m_alpha[])
+ * et l'index d'écriture est commun. Les historiques sont entrelacés : l'échantillon r
+ * de la ligne l est à m_history[r * LANES + l], une trame de LANES échantillons par
+ * index. Positions et gains des taps de toutes les lignes sont calculés une fois par
+ * bloc, tap par tap, par une boucle sur les lignes sans branche que le compilateur
+ * vectorise ; sin(pi*alpha) reste un appel scalaire par ligne. Les lectures, à des
+ * positions différentes d'une ligne à l'autre, sont des gathers (BankKernel, AVX2 ou
+ * AVX-512, voir MultiTapSincDelaySimd.h). Une ligne à délai fixe (tau1 == tau2) lit
+ * un seul tap de gain unitaire, comme MultiTapSincDelay.
+ *
+ * Le coût fixe d'un bloc (positions, gains, appel du noyau) est partagé par LANES
+ * lignes : la banque est avantageuse pour les petits blocs (32 à 64 échantillons). Sur
+ * de grands blocs, les lignes Mirrored séparées, dont les lectures sont contiguës,
+ * restent plus rapides qu'une lecture par gather.
+ *
+ * L'interpolation est linéaire, les paramètres sont constants sur le bloc (pas de
+ * rampe de alpha) et les blocs sont traités par sous-blocs écrits puis lus, comme la
+ * disposition Mirrored.
+ * @param T Le type des échantillons.
+ * @param P Le type des paramètres (voir MultiTapSincDelay).
+ * @param LANES Le nombre de lignes, 8 ou 16.
+ */
+template <typename T = float, typename P = double, size_t LANES = 8>
+class MultiTapSincDelayBank {
+    static_assert(LANES == 8 || LANES == 16, "A bank holds 8 or 16 lines.");
+
+   public:
+    static constexpr size_t kLanes        = LANES;
+    static constexpr size_t kMaxBlockSize = SincDelayBuffer<T>::kMaxBlockSize;
+
+    /**
+     * Constructeur. Toutes les lignes sont initialisées à tau1 = 1, tau2 = 2, alpha = 0.
+     * @param max_delay_samples Délai maximal (en échantillons), commun à toutes les lignes.
+     * @param initial_K Valeur initiale du paramètre K, commun à toutes les lignes.
+     */
+    MultiTapSincDelayBank(size_t max_delay_samples, int initial_K = 1)
+        : m_max_delay_samples(max_delay_samples),
+          m_K(0),
+          m_size(1),
+          m_writeIndex(0),
+          m_kernel(bankKernel<T>(SimdLevel::Scalar)),
+          m_simdLevel(SimdLevel::Scalar)
+    {
+        if (max_delay_samples == 0) {
+            MTSD_THROW(std::invalid_argument, "Max delay samples must be greater than 0.");
+        }
+        // Un sous-bloc entier est écrit avant d'être lu, comme la disposition Mirrored
+        while (m_size < max_delay_samples + kMaxBlockSize) {
+            m_size <<= 1;
+        }
+        if (m_size * LANES > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+            MTSD_THROW(std::invalid_argument, "Max delay samples too large for gather indices.");
+        }
+        m_history.assign(m_size * LANES, T(0));
+        m_frame.resize(kMaxBlockSize * LANES);
+        std::fill(m_tau1, m_tau1 + LANES, P(1));
+        std::fill(m_tau2, m_tau2 + LANES, P(2));
+        std::fill(m_alpha, m_alpha + LANES, P(0));
+        setK(initial_K);
+        setSimdLevel(detectSimdLevel());
+    }
+
+    /**
+     * Définit le paramètre K (nombre de paires de taps auxiliaires) de toutes les lignes.
+     */
+    void setK(int newK)
+    {
+        reserveK(newK);
+        if (trySetK(newK) != SincDelayStatus::Ok) {
+            MTSD_THROW(std::invalid_argument, "K cannot be negative.");
+        }
+    }
+
+    /**
+     * Réserve la mémoire des taps jusqu'à max_K, pour que trySetK() n'alloue jamais.
+     */
+    void reserveK(int max_K)
+    {
+        if (max_K < 0) {
+            MTSD_THROW(std::invalid_argument, "K cannot be negative.");
+        }
+        const size_t size = (2 * static_cast<size_t>(max_K) + 2) * LANES;
+        m_offsets.reserve(size);
+        m_c0.reserve(size);
+        m_c1.reserve(size);
+    }
+
+    /**
+     * Variante de setK() sans exception ni allocation, utilisable depuis le thread audio.
+     * @return InvalidK si K est négatif ou au-delà de la capacité réservée (voir
+     * reserveK), Ok sinon.
+     */
+    SincDelayStatus trySetK(int newK) noexcept
+    {
+        if (newK < 0 || (2 * static_cast<size_t>(newK) + 2) * LANES > m_offsets.capacity()) {
+            return SincDelayStatus::InvalidK;
+        }
+        m_K                   = newK;
+        const size_t num_taps = static_cast<size_t>(numTaps());
+        m_offsets.resize(num_taps * LANES);  // Dans la capacité réservée : pas d'allocation
+        m_c0.resize(num_taps * LANES);
+        m_c1.resize(num_taps * LANES);
+        return SincDelayStatus::Ok;
+    }
+
+    int    getK() const { return m_K; }
+    int    numTaps() const { return 2 * m_K + 2; }
+    size_t numLines() const { return LANES; }
+
+    /**
+     * Définit les délais et le facteur d'interpolation d'une ligne.
+     * @param line L'index de la ligne, dans [0, LANES).
+     */
+    void setDelay(size_t line, P tau1, P tau2, P alpha)
+    {
+        if (line >= LANES) {
+            MTSD_THROW(std::out_of_range, "Line index out of range.");
+        }
+        if (trySetDelay(line, tau1, tau2, alpha) != SincDelayStatus::Ok) {
+            if (alpha < P(0) || alpha > P(1) || alpha != alpha) {
+                MTSD_THROW(std::invalid_argument, "Alpha must be between 0.0 and 1.0.");
+            }
+            MTSD_THROW(std::out_of_range,
+                       "Tau1 and tau2 must be between 0.0 and max_delay_samples - 1.0");
+        }
+    }
+
+    /**
+     * Variante de setDelay() sans exception. Une valeur hors limites est ignorée ou
+     * ramenée dans les limites selon policy ; si l'une est ignorée, ou si line est hors
+     * de [0, LANES), la ligne n'est pas modifiée.
+     * @return OutOfRange si la ligne n'est pas modifiée, Clamped si une valeur a été
+     * ramenée dans les limites, Ok sinon.
+     */
+    SincDelayStatus trySetDelay(size_t line, P tau1, P tau2, P alpha,
+                                ParamPolicy policy = ParamPolicy::Reject) noexcept
+    {
+        if (line >= LANES) {
+            return SincDelayStatus::OutOfRange;
+        }
+        const P         max_tau = std::nextafter(static_cast<P>(m_max_delay_samples) - P(1), P(0));
+        SincDelayStatus status  = SincDelayStatus::Ok;
+        for (SincDelayStatus check : {checkRange(tau1, P(0), max_tau, policy),
+                                      checkRange(tau2, P(0), max_tau, policy),
+                                      checkRange(alpha, P(0), P(1), policy)}) {
+            if (check == SincDelayStatus::OutOfRange) {
+                return check;
+            }
+            if (check == SincDelayStatus::Clamped) {
+                status = check;
+            }
+        }
+        m_tau1[line]  = tau1;
+        m_tau2[line]  = tau2;
+        m_alpha[line] = alpha;
+        return status;
+    }
+
+    P tau1(size_t line) const { return m_tau1[line]; }
+    P tau2(size_t line) const { return m_tau2[line]; }
+    P alpha(size_t line) const { return m_alpha[line]; }
+
+    /**
+     * Traite un bloc des LANES lignes. Les paramètres sont constants sur le bloc.
+     * Le traitement en place (outs[l] == ins[l]) est supporté.
+     * @param ins Les LANES blocs d'entrée, un par ligne.
+     * @param outs Les LANES blocs de sortie, un par ligne.
+     * @param n Le nombre d'échantillons du bloc.
+     */
+    void process(const T* const* ins, T* const* outs, size_t n) noexcept
+    {
+        updateTaps();
+
+        for (size_t start = 0; start < n; start += kMaxBlockSize) {
+            const size_t count = std::min(kMaxBlockSize, n - start);
+
+            // Écrire les trames du sous-bloc avant de les lire (traitement en place)
+            const size_t writeIndex = m_writeIndex;
+            for (size_t i = 0; i < count; ++i) {
+                T* frame = &m_history[((writeIndex + i) & (m_size - 1)) * LANES];
+                for (size_t l = 0; l < LANES; ++l) {
+                    frame[l] = ins[l][start + i];
+                }
+            }
+            m_writeIndex = (writeIndex + count) & (m_size - 1);
+
+            m_kernel(m_frame.data(), m_history.data(), m_offsets.data(), m_c0.data(),
+                     m_c1.data(), numTaps(), static_cast<int>(LANES),
+                     static_cast<uint32_t>(writeIndex * LANES),
+                     static_cast<uint32_t>(m_size * LANES - 1), count);
+
+            for (size_t i = 0; i < count; ++i) {
+                const T* frame = &m_frame[i * LANES];
+                for (size_t l = 0; l < LANES; ++l) {
+                    outs[l][start + i] = frame[l];
+                }
+            }
+        }
+    }
+
+    /**
+     * Force le jeu d'instructions du noyau de lecture ; SSE2, sans gather, et les jeux
+     * non supportés par le CPU utilisent le noyau scalaire, et AVX-512 en float sur 8
+     * lignes (un seul vecteur de 256 bits) le noyau AVX2.
+     */
+    void setSimdLevel(SimdLevel level)
+    {
+        if (!simdSupported(level) || level == SimdLevel::SSE2) {
+            level = SimdLevel::Scalar;
+        }
+        if (level == SimdLevel::AVX512 && sizeof(T) == sizeof(float) && LANES == 8) {
+            level = SimdLevel::AVX2;
+        }
+        m_simdLevel = level;
+        m_kernel    = bankKernel<T>(level);
+    }
+
+    /**
+     * Retourne le jeu d'instructions effectivement utilisé par le noyau de lecture.
+     */
+    SimdLevel simdLevel() const { return m_simdLevel; }
+
+   private:
+    /**
+     * Calcule positions et gains des taps de toutes les lignes (Equations 17 et 19),
+     * une fois par bloc. Pour chaque tap, la boucle sur les lignes est sans branche ni
+     * appel de bibliothèque (conversions entières, comparaisons converties en 0 ou 1,
+     * division) : le compilateur la vectorise sur les LANES lignes. Seul sin(pi*alpha)
+     * reste un appel scalaire, un par ligne et par bloc. Les coefficients c0 et c1 de
+     * l'interpolation linéaire incluent le gain du tap.
+     *
+     * Délai fixe (tau1 == tau2, même tolérance que MultiTapSincDelay) : la ligne est
+     * traitée avec alpha = 0, soit un seul tap de gain unitaire à tau1, les autres taps
+     * ayant des coefficients nuls.
+     */
+    void updateTaps()
+    {
+        const int    K            = m_K;
+        const double size         = static_cast<double>(m_size);
+        const P      epsilon      = std::numeric_limits<P>::epsilon() * 100;
+        const double sinc_epsilon = std::numeric_limits<double>::epsilon();
+
+        double tau1[LANES];
+        double tau2[LANES];
+        double delta[LANES];
+        double alpha[LANES];
+        double sin_pi_alpha[LANES];
+        for (size_t l = 0; l < LANES; ++l) {
+            const bool fixed = std::abs(m_tau2[l] - m_tau1[l]) < epsilon;
+            tau1[l]          = static_cast<double>(m_tau1[l]);
+            tau2[l]          = static_cast<double>(m_tau2[l]);
+            delta[l]         = tau2[l] - tau1[l];
+            alpha[l]         = fixed ? 0.0 : static_cast<double>(m_alpha[l]);
+        }
+        for (size_t l = 0; l < LANES; ++l) {
+            sin_pi_alpha[l] = std::sin(M_PI * alpha[l]);
+        }
+
+        for (int k = 0; k < numTaps(); ++k) {
+            // Taps k <= K ancrés sur tau1, les autres sur tau2 (voir sincTapPositions)
+            const double* anchor  = (k <= K) ? tau1 : tau2;
+            const double  steps   = static_cast<double>((k <= K) ? k - K : k - K - 1);
+            const int     n       = k - K;
+            const double  sign    = (n % 2 == 0) ? -1.0 : 1.0;  // sin(pi*(n - alpha))
+            uint32_t*     offsets = &m_offsets[static_cast<size_t>(k) * LANES];
+            T*            c0      = &m_c0[static_cast<size_t>(k) * LANES];
+            T*            c1      = &m_c1[static_cast<size_t>(k) * LANES];
+            for (size_t l = 0; l < LANES; ++l) {
+                // Position ramenée dans [0, taille du buffer) par deux troncatures
+                // entières, sans floor ni comparaison (|tk| reste petit devant 2^31 tailles)
+                double tk = anchor[l] + steps * delta[l];
+                tk -= static_cast<double>(static_cast<int32_t>(tk / size)) * size;
+                tk += size;
+                tk -= static_cast<double>(static_cast<int32_t>(tk / size)) * size;
+
+                // Gain hk = sinc(n - alpha), 1 au centre exact (division sans condition)
+                double x      = static_cast<double>(n) - alpha[l];
+                double center = static_cast<double>(std::abs(x) < sinc_epsilon);
+                double ratio  = sign * sin_pi_alpha[l] / (M_PI * (x + center));
+                double gain   = ratio + center * (1.0 - ratio);
+
+                // Position relative à l'index d'écriture, dans (0, taille] : troncature
+                // = floor, puis index d'élément de l'historique entrelacé
+                double  position = size - tk;
+                int32_t frame    = static_cast<int32_t>(position);
+                T       frac     = static_cast<T>(position - static_cast<double>(frame));
+
+                offsets[l] = static_cast<uint32_t>(frame) * static_cast<uint32_t>(LANES) +
+                             static_cast<uint32_t>(l);
+                c0[l]      = static_cast<T>(gain) * (T(1) - frac);
+                c1[l]      = static_cast<T>(gain) * frac;
+            }
+        }
+    }
+
+    size_t m_max_delay_samples;
+    int    m_K;
+    size_t m_size;  // Nombre de trames de l'historique (puissance de deux)
+
+    // Paramètres des lignes (SoA)
+    P m_tau1[LANES];
+    P m_tau2[LANES];
+    P m_alpha[LANES];
+
+    // Historiques entrelacés et index d'écriture commun
+    std::vector<T> m_history;  // m_history[r * LANES + l] : échantillon r de la ligne l
+    size_t         m_writeIndex;
+    std::vector<T> m_frame;  // Sorties entrelacées d'un sous-bloc
+
+    // Taps de toutes les lignes, rangés k * LANES + l, calculés une fois par bloc
+    std::vector<uint32_t> m_offsets;  // Index entier * LANES + l, relatif à l'index d'écriture
+    std::vector<T>        m_c0;       // Gain * (1 - frac)
+    std::vector<T>        m_c1;       // Gain * frac
+
+    BankKernel<T> m_kernel;
+    SimdLevel     m_simdLevel;
+};
+
+#endif  // MULTI_TAP_SINC_DELAY_BANK_H
@@ -0,0 +1,1294 @@
+#include <algorithm>
+#include <cmath>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "MultiTapSincDelayBank.h"
+#include "MultiTapSincDelayFactory.h"
+#include "ParallelSincDelayBank.h"
+#include "SincDelayControl.h"
+#include "SincDelayTracker.h"
+#include "WfsRenderMatrix.h"
+
+// Mesure du débit de MultiTapSincDelay en double, float et précision mixte
+// (échantillons float, paramètres double), avec K dynamique ou fixé à la compilation.
+// Avant les mesures, chaque noyau SIMD supporté est vérifié contre le noyau scalaire.
+// La matrice de rendu WFS est comparée à des lignes séparées sommées, et le mixage
+// d'une banque parallèle doit être identique au bit près quel que soit le nombre de threads.
+// Les paramètres publiés par un thread de contrôle doivent arriver cohérents au thread audio.
+// Les rampes de alpha intégrées par process() sont comparées à des setAlpha() par échantillon.
+// Le suivi de délais cibles doit enchaîner ou fusionner les cibles et finir sur la dernière.
+// L'élagage des taps (alpha entier, gains sous un seuil) est comparé au calcul complet,
+// et le chemin delta entier (une interpolation pour tous les taps) au calcul tap par tap.
+// Un délai fixe entier doit rendre l'entrée retardée exactement (copies de blocs), et les
+// lectures à position en virgule fixe 32.32 suivre les lectures en virgule flottante.
+// Une banque vectorisée à travers les lignes est comparée à des lignes séparées.
+
+const SimdLevel allSimdLevels[] = {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2,
+                                   SimdLevel::AVX512};
+
+/**
+ * Vérifie chaque noyau SIMD supporté contre tapKernelScalar, sur des plages
+ * aléatoires, avec la tolérance documentée par simdTolerance().
+ * @return true si tous les noyaux sont dans la tolérance.
+ */
+template <typename T>
+bool checkTapKernels(const char* name)
+{
+    std::mt19937                      rng(2);
+    std::uniform_real_distribution<T> noise(T(-1), T(1));
+    bool                              ok = true;
+
+    for (SimdLevel level : allSimdLevels) {
+        if (!simdSupported(level)) {
+            std::printf("kernel %-6s %-6s : not supported, skipped\n", simdLevelName(level), name);
+            continue;
+        }
+        TapKernel<T> kernel    = tapKernel<T>(level);
+        double       max_ratio = 0.0;
+        for (int points : {1, 2, 4, 8}) {
+            for (size_t n : {1, 7, 64, 255, 256}) {
+                std::vector<T> src(n + static_cast<size_t>(points) - 1);
+                std::vector<T> coeffs(static_cast<size_t>(points));
+                std::vector<T> acc(n);
+                for (T& x : src) {
+                    x = noise(rng);
+                }
+                for (T& c : coeffs) {
+                    c = noise(rng);
+                }
+                for (T& a : acc) {
+                    a = noise(rng);
+                }
+                std::vector<T> ref = acc;
+                tapKernelScalar(ref.data(), src.data(), coeffs.data(), points, n);
+                kernel(acc.data(), src.data(), coeffs.data(), points, n);
+
+                for (size_t i = 0; i < n; ++i) {
+                    // Borne : simdTolerance * (|acc| + sum |coeffs[p] * src[i+p]|)
+                    double bound = std::abs(static_cast<double>(ref[i]));
+                    for (int p = 0; p < points; ++p) {
+                        bound += std::abs(static_cast<double>(coeffs[p] * src[i + p]));
+                    }
+                    bound *= static_cast<double>(simdTolerance<T>());
+                    double error = std::abs(static_cast<double>(acc[i] - ref[i]));
+                    max_ratio    = std::max(max_ratio, bound > 0.0 ? error / bound : error);
+                }
+            }
+        }
+        bool level_ok = max_ratio <= 1.0;
+        ok            = ok && level_ok;
+        std::printf("kernel %-6s %-6s : %s (max error / tolerance = %.3f)\n", simdLevelName(level),
+                    name, level_ok ? "ok" : "FAILED", max_ratio);
+    }
+    return ok;
+}
+
+/**
+ * Vérifie process() (disposition Mirrored) pour chaque jeu d'instructions contre
+ * le noyau scalaire. Avec |x| <= 1 et |hk| <= 1, l'écart par échantillon est borné
+ * par simdTolerance * 2 * (2K+2) (deux points d'interpolation par tap).
+ * @return true si toutes les sorties sont dans la tolérance.
+ */
+template <typename T, typename P>
+bool checkProcessKernels(const char* name, int K)
+{
+    const size_t maxDelay  = 8192;
+    const size_t blockSize = 300;  // Plus grand qu'un sous-bloc, non multiple des vecteurs
+    const double bound     = static_cast<double>(simdTolerance<T>()) * 2.0 * (2 * K + 2);
+    bool         ok        = true;
+
+    for (SimdLevel level : allSimdLevels) {
+        if (!simdSupported(level) || level == SimdLevel::Scalar) {
+            continue;
+        }
+        MultiTapSincDelay<T, P> ref(maxDelay, K, P(44100.0), BufferLayout::Mirrored);
+        MultiTapSincDelay<T, P> line(maxDelay, K, P(44100.0), BufferLayout::Mirrored);
+        ref.setSimdLevel(SimdLevel::Scalar);
+        line.setSimdLevel(level);
+
+        std::mt19937                      rng(3);
+        std::uniform_real_distribution<T> noise(T(-1), T(1));
+        std::vector<T>                    input(blockSize);
+        std::vector<T>                    out_ref(blockSize);
+        std::vector<T>                    out(blockSize);
+        double                            max_error = 0.0;
+        for (int b = 0; b < 50; ++b) {
+            P alpha = static_cast<P>(b) / P(49);
+            for (auto* delay : {&ref, &line}) {
+                delay->setTau1(P(1000.25) + P(b));
+                delay->setTau2(P(1030.5) + P(b));
+                delay->setAlpha(alpha);
+            }
+            for (T& x : input) {
+                x = noise(rng);
+            }
+            ref.process(input.data(), out_ref.data(), blockSize);
+            line.process(input.data(), out.data(), blockSize);
+            for (size_t i = 0; i < blockSize; ++i) {
+                max_error =
+                    std::max(max_error, std::abs(static_cast<double>(out[i] - out_ref[i])));
+            }
+        }
+        bool level_ok = max_error <= bound;
+        ok            = ok && level_ok;
+        std::printf("process %-6s %-13s K=%-2d : %s (max error %.3g, tolerance %.3g)\n",
+                    simdLevelName(level), name, K, level_ok ? "ok" : "FAILED", max_error, bound);
+    }
+    return ok;
+}
+
+/**
+ * Mesure le temps moyen par échantillon (en ns) d'une banque de lignes à retard.
+ * alpha varie d'un bloc à l'autre pour rester dans le cas général (variable).
+ * @param name Le nom affiché pour la configuration mesurée.
+ * @param fixedK true pour utiliser la spécialisation à K fixé (makeMultiTapSincDelay).
+ */
+template <typename T, typename P>
+void benchThroughput(const char* name, int K, bool fixedK, BufferLayout layout, size_t numLines,
+                     size_t blockSize, size_t numBlocks)
+{
+    const size_t maxDelay = 1 << 16;
+
+    // Les deux variantes passent par l'interface virtuelle pour une comparaison équitable
+    std::vector<std::unique_ptr<MultiTapSincDelayInterface<T, P>>> lines;
+    for (size_t l = 0; l < numLines; ++l) {
+        if (fixedK) {
+            lines.push_back(makeMultiTapSincDelay<T, P>(maxDelay, K, P(44100.0), layout));
+        } else {
+            lines.emplace_back(
+                new MultiTapSincDelayAdapter<T, P, -1>(maxDelay, K, P(44100.0), layout));
+        }
+        lines.back()->setTau1(P(100.5) + P(l));
+        lines.back()->setTau2(P(5000.7) + P(l));
+    }
+
+    std::mt19937                      rng(1);
+    std::uniform_real_distribution<T> noise(T(-1), T(1));
+    std::vector<T>                    input(blockSize);
+    std::vector<T>                    output(blockSize);
+    for (T& sample : input) {
+        sample = noise(rng);
+    }
+
+    // Meilleur temps sur plusieurs passes pour limiter le bruit de mesure
+    double best = 1e300;
+    for (int pass = 0; pass < 5; ++pass) {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t b = 0; b < numBlocks; ++b) {
+            P alpha = static_cast<P>(b % 100) / P(99);
+            for (auto& line : lines) {
+                line->setAlpha(alpha);
+                line->process(input.data(), output.data(), blockSize);
+            }
+        }
+        auto   stop = std::chrono::steady_clock::now();
+        double ns   = std::chrono::duration<double, std::nano>(stop - start).count();
+        best        = std::min(best, ns);
+    }
+
+    double samples = static_cast<double>(numLines * blockSize * numBlocks);
+    std::printf("%-14s K=%-2d %-7s %-10s lines=%zu block=%zu : %8.2f ns/sample\n", name, K,
+                fixedK ? "fixed" : "dynamic",
+                (layout == BufferLayout::Mirrored) ? "mirrored" : "pow2", numLines, blockSize,
+                best / samples);
+}
+
+/**
+ * Vérifie WfsRenderMatrix contre des MultiTapSincDelay séparés (disposition Mirrored),
+ * pondérés et sommés par haut-parleur. Une route sur trois est muette, une sur cinq
+ * à délai fixe.
+ * @return true si l'écart est dans la tolérance.
+ */
+template <typename T, typename P>
+bool checkRenderMatrix(const char* name, int K)
+{
+    const size_t maxDelay    = 8192;
+    const size_t numSources  = 4;
+    const size_t numSpeakers = 6;
+    const size_t blockSize   = 300;
+    const double bound =
+        static_cast<double>(simdTolerance<T>()) * 4.0 * (2 * K + 2) * numSources;
+
+    WfsRenderMatrix<T, P>                matrix(maxDelay, numSources, numSpeakers, K);
+    std::vector<MultiTapSincDelay<T, P>> lines;
+    for (size_t r = 0; r < numSources * numSpeakers; ++r) {
+        lines.emplace_back(maxDelay, K, P(44100.0), BufferLayout::Mirrored);
+    }
+
+    std::mt19937                      rng(4);
+    std::uniform_real_distribution<T> noise(T(-1), T(1));
+    std::vector<std::vector<T>>       ins(numSources, std::vector<T>(blockSize));
+    std::vector<std::vector<T>>       outs(numSpeakers, std::vector<T>(blockSize));
+    std::vector<const T*>             in_ptrs;
+    std::vector<T*>                   out_ptrs;
+    for (auto& in : ins) {
+        in_ptrs.push_back(in.data());
+    }
+    for (auto& out : outs) {
+        out_ptrs.push_back(out.data());
+    }
+    std::vector<T> line_out(blockSize);
+    double         max_error = 0.0;
+
+    for (int b = 0; b < 20; ++b) {
+        for (size_t s = 0; s < numSources; ++s) {
+            for (size_t m = 0; m < numSpeakers; ++m) {
+                size_t r     = s * numSpeakers + m;
+                P      tau1  = P(500.25) + P(37 * r) + P(b);
+                P      tau2  = (r % 5 == 0) ? tau1 : tau1 + P(20.5);
+                P      alpha = static_cast<P>((b + r) % 10) / P(9);
+                T      gain  = (r % 3 == 0) ? T(0) : T(0.5) + T(0.1) * T(m);
+                matrix.setDelay(s, m, tau1, tau2, alpha);
+                matrix.setGain(s, m, gain);
+                lines[r].setTau1(tau1);
+                lines[r].setTau2(tau2);
+                lines[r].setAlpha(alpha);
+            }
+            for (T& x : ins[s]) {
+                x = noise(rng);
+            }
+        }
+        matrix.process(in_ptrs.data(), out_ptrs.data(), blockSize);
+
+        std::vector<std::vector<T>> ref(numSpeakers, std::vector<T>(blockSize, T(0)));
+        for (size_t s = 0; s < numSources; ++s) {
+            for (size_t m = 0; m < numSpeakers; ++m) {
+                lines[s * numSpeakers + m].process(ins[s].data(), line_out.data(), blockSize);
+                for (size_t i = 0; i < blockSize; ++i) {
+                    ref[m][i] += matrix.gain(s, m) * line_out[i];
+                }
+            }
+        }
+        for (size_t m = 0; m < numSpeakers; ++m) {
+            for (size_t i = 0; i < blockSize; ++i) {
+                max_error =
+                    std::max(max_error, std::abs(static_cast<double>(outs[m][i] - ref[m][i])));
+            }
+        }
+    }
+    bool ok = max_error <= bound;
+    std::printf("matrix %-13s K=%-2d : %s (max error %.3g, tolerance %.3g)\n", name, K,
+                ok ? "ok" : "FAILED", max_error, bound);
+    return ok;
+}
+
+/**
+ * Mesure le temps par échantillon et par route (en ns) du rendu N x M, avec la
+ * matrice ou avec des lignes séparées sommées dans des buffers temporaires.
+ */
+template <typename T, typename P>
+void benchRenderMatrix(const char* name, int K, size_t numSources, size_t numSpeakers,
+                       size_t blockSize, size_t numBlocks)
+{
+    const size_t maxDelay = 1 << 16;
+
+    WfsRenderMatrix<T, P>                matrix(maxDelay, numSources, numSpeakers, K);
+    std::vector<MultiTapSincDelay<T, P>> lines;
+    for (size_t s = 0; s < numSources; ++s) {
+        for (size_t m = 0; m < numSpeakers; ++m) {
+            P tau1 = P(100.5) + P(13 * s + 7 * m);
+            matrix.setDelay(s, m, tau1, tau1 + P(50.3), P(0.5));
+            matrix.setGain(s, m, T(0.5));
+            lines.emplace_back(maxDelay, K, P(44100.0), BufferLayout::Mirrored);
+            lines.back().setTau1(tau1);
+            lines.back().setTau2(tau1 + P(50.3));
+        }
+    }
+
+    std::mt19937                      rng(5);
+    std::uniform_real_distribution<T> noise(T(-1), T(1));
+    std::vector<std::vector<T>>       ins(numSources, std::vector<T>(blockSize));
+    std::vector<std::vector<T>>       outs(numSpeakers, std::vector<T>(blockSize));
+    std::vector<const T*>             in_ptrs;
+    std::vector<T*>                   out_ptrs;
+    for (auto& in : ins) {
+        for (T& x : in) {
+            x = noise(rng);
+        }
+        in_ptrs.push_back(in.data());
+    }
+    for (auto& out : outs) {
+        out_ptrs.push_back(out.data());
+    }
+    std::vector<T> temp(blockSize);
+
+    for (bool useMatrix : {false, true}) {
+        double best = 1e300;
+        for (int pass = 0; pass < 5; ++pass) {
+            auto start = std::chrono::steady_clock::now();
+            for (size_t b = 0; b < numBlocks; ++b) {
+                if (useMatrix) {
+                    matrix.process(in_ptrs.data(), out_ptrs.data(), blockSize);
+                    continue;
+                }
+                for (auto& out : outs) {
+                    std::fill(out.begin(), out.end(), T(0));
+                }
+                for (size_t s = 0; s < numSources; ++s) {
+                    for (size_t m = 0; m < numSpeakers; ++m) {
+                        lines[s * numSpeakers + m].process(ins[s].data(), temp.data(), blockSize);
+                        for (size_t i = 0; i < blockSize; ++i) {
+                            outs[m][i] += T(0.5) * temp[i];
+                        }
+                    }
+                }
+            }
+            auto   stop = std::chrono::steady_clock::now();
+            double ns   = std::chrono::duration<double, std::nano>(stop - start).count();
+            best        = std::min(best, ns);
+        }
+        double samples = static_cast<double>(numSources * numSpeakers * blockSize * numBlocks);
+        std::printf("%-14s K=%-2d %-8s %zux%zu block=%zu : %8.2f ns/sample/route\n", name, K,
+                    useMatrix ? "matrix" : "separate", numSources, numSpeakers, blockSize,
+                    best / samples);
+    }
+}
+
+/**
+ * Remplit les paramètres et les entrées d'une banque pour le bloc b.
+ */
+template <typename T, typename P>
+void prepareBankBlock(ParallelSincDelayBank<T, P>& bank, std::vector<std::vector<T>>& ins, int b,
+                      std::mt19937& rng)
+{
+    std::uniform_real_distribution<T> noise(T(-1), T(1));
+    for (size_t l = 0; l < bank.numLines(); ++l) {
+        bank.line(l).setTau1(P(100.5) + P(l));
+        bank.line(l).setTau2(P(5000.7) + P(l));
+        bank.line(l).setAlpha(static_cast<P>((b + static_cast<int>(l)) % 100) / P(99));
+        for (T& x : ins[l]) {
+            x = noise(rng);
+        }
+    }
+}
+
+/**
+ * Vérifie que le mixage d'une ParallelSincDelayBank est identique au bit près pour
+ * 1, 2, 3 et 4 threads.
+ * @return true si tous les mixages sont identiques.
+ */
+template <typename T, typename P>
+bool checkParallelBank(const char* name, int K)
+{
+    const size_t numLines  = 37;  // Dernier groupe incomplet
+    const size_t blockSize = 256;
+    bool         ok        = true;
+
+    std::vector<T> ref_mix;
+    for (size_t threads : {1, 2, 3, 4}) {
+        RealtimeThreadPool          pool(threads, false);
+        ParallelSincDelayBank<T, P> bank(numLines, 1 << 14, K, blockSize);
+        std::vector<std::vector<T>> ins(numLines, std::vector<T>(blockSize));
+        std::vector<const T*>       in_ptrs;
+        for (auto& in : ins) {
+            in_ptrs.push_back(in.data());
+        }
+        std::mt19937   rng(6);
+        std::vector<T> mix(blockSize);
+        std::vector<T> all_mix;
+        for (int b = 0; b < 20; ++b) {
+            prepareBankBlock(bank, ins, b, rng);
+            bank.process(pool, in_ptrs.data(), nullptr, mix.data(), blockSize);
+            all_mix.insert(all_mix.end(), mix.begin(), mix.end());
+        }
+        if (threads == 1) {
+            ref_mix = all_mix;
+            continue;
+        }
+        bool same = std::memcmp(ref_mix.data(), all_mix.data(), ref_mix.size() * sizeof(T)) == 0;
+        ok        = ok && same;
+        std::printf("bank %-13s K=%-2d threads=%zu : %s\n", name, K, threads,
+                    same ? "ok (bit-identical mix)" : "FAILED (mix differs)");
+    }
+    return ok;
+}
+
+/**
+ * Mesure le temps par échantillon et par ligne (en ns) d'une ParallelSincDelayBank.
+ */
+template <typename T, typename P>
+void benchParallelBank(const char* name, int K, size_t numLines, size_t threads,
+                       size_t blockSize, size_t numBlocks)
+{
+    RealtimeThreadPool          pool(threads);
+    ParallelSincDelayBank<T, P> bank(numLines, 1 << 16, K, blockSize);
+    std::vector<std::vector<T>> ins(numLines, std::vector<T>(blockSize));
+    std::vector<const T*>       in_ptrs;
+    for (auto& in : ins) {
+        in_ptrs.push_back(in.data());
+    }
+    std::mt19937   rng(7);
+    std::vector<T> mix(blockSize);
+    prepareBankBlock(bank, ins, 0, rng);
+
+    double best = 1e300;
+    for (int pass = 0; pass < 5; ++pass) {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t b = 0; b < numBlocks; ++b) {
+            bank.process(pool, in_ptrs.data(), nullptr, mix.data(), blockSize);
+        }
+        auto   stop = std::chrono::steady_clock::now();
+        double ns   = std::chrono::duration<double, std::nano>(stop - start).count();
+        best        = std::min(best, ns);
+    }
+    double samples = static_cast<double>(numLines * blockSize * numBlocks);
+    std::printf("%-14s K=%-2d bank lines=%zu threads=%zu block=%zu : %8.2f ns/sample/line\n",
+                name, K, numLines, threads, blockSize, best / samples);
+}
+
+/**
+ * Publie des jeux de paramètres depuis un thread de contrôle pendant que le thread
+ * courant traite des blocs, et vérifie que chaque jeu appliqué est cohérent :
+ * tau2 - tau1, alpha et K sont tous déduits de tau1 par le thread de contrôle.
+ * @return true si aucun jeu déchiré n'a été observé.
+ */
+bool checkParameterMailbox()
+{
+    const int                          numUpdates = 200000;
+    ControlledSincDelay<float, double> delay(1 << 14, 0, 4);
+    std::atomic<bool>                  done(false);
+
+    std::thread control([&]() {
+        for (int u = 1; u <= numUpdates; ++u) {
+            int    step = 1 + u % 10000;
+            double tau1 = static_cast<double>(step);
+            delay.publish({tau1, tau1 + 10.0, (step % 7) / 6.0, step % 5});
+            if (u % 256 == 0) {
+                std::this_thread::yield();  // Entrelace les deux threads sur un seul cœur
+            }
+        }
+        done.store(true);
+    });
+
+    std::vector<float> block(64, 0.5f);
+    size_t             numApplied = 0;
+    size_t             numTorn    = 0;
+    double             lastTau1   = -1.0;
+    for (bool finished = false; !finished;) {
+        finished = done.load();
+        delay.process(block.data(), block.data(), block.size());
+        const SincDelayParams<double>& p    = delay.current();
+        int                            step = static_cast<int>(p.tau1);
+        if (p.tau1 != lastTau1) {
+            ++numApplied;
+            lastTau1 = p.tau1;
+        }
+        bool initial = (p.tau1 == 1.0 && p.tau2 == 2.0);  // Avant la première publication
+        if (!initial &&
+            (p.tau2 != p.tau1 + 10.0 || p.alpha != (step % 7) / 6.0 || p.K != step % 5 ||
+             delay.line().getK() != p.K)) {
+            ++numTorn;
+        }
+    }
+    control.join();
+
+    // Le dernier jeu publié est appliqué au bloc suivant
+    delay.process(block.data(), block.data(), block.size());
+    bool ok = numTorn == 0 && delay.current().tau1 == 1.0 + (numUpdates % 10000);
+    std::printf("mailbox : %s (%d updates published, %zu applied, %zu torn)\n",
+                ok ? "ok" : "FAILED", numUpdates, numApplied, numTorn);
+    return ok;
+}
+
+/**
+ * Vérifie les rampes de alpha (disposition Mirrored, blocs de taille aléatoire,
+ * rampes commençant et finissant en milieu de bloc) contre une ligne pilotée par
+ * setAlpha() à chaque échantillon. L'écart vient de la dérive du phaseur de sin(pi*alpha).
+ * @return true si l'écart est dans la tolérance.
+ */
+template <typename T, typename P>
+bool checkAlphaRamp(const char* name, int K, double tolerance)
+{
+    const size_t maxDelay = 8192;
+
+    MultiTapSincDelay<T, P> ref(maxDelay, K, P(44100.0), BufferLayout::PowerOfTwo);
+    MultiTapSincDelay<T, P> line(maxDelay, K, P(44100.0), BufferLayout::Mirrored);
+    ref.setTau1(P(1000.25));
+    ref.setTau2(P(1030.5));
+    line.setTau1(P(1000.25));
+    line.setTau2(P(1030.5));
+
+    std::mt19937                      rng(8);
+    std::uniform_real_distribution<T> noise(T(-1), T(1));
+    double                            max_error = 0.0;
+    for (int r = 0; r < 20; ++r) {
+        P      start  = line.getAlpha();
+        P      target = static_cast<P>((r * 7) % 11) / P(10);
+        size_t length = rng() % 1000;
+        size_t offset = rng() % 300;
+        line.rampAlpha(target, length, offset);
+        P step = (length > 0) ? (target - start) / static_cast<P>(length) : P(0);
+
+        size_t total = offset + length + rng() % 200;
+        for (size_t done = 0; done < total;) {
+            size_t         n = std::min<size_t>(1 + rng() % 500, total - done);
+            std::vector<T> input(n);
+            std::vector<T> out(n);
+            for (T& x : input) {
+                x = noise(rng);
+            }
+            line.process(input.data(), out.data(), n);
+            for (size_t i = 0; i < n; ++i, ++done) {
+                P alpha = start;
+                if (done >= offset) {
+                    size_t pos = std::min(done - offset, length);
+                    alpha      = (pos == length) ? target : start + static_cast<P>(pos) * step;
+                }
+                ref.setAlpha(alpha);
+                max_error = std::max(
+                    max_error, std::abs(static_cast<double>(ref.process(input[i]) - out[i])));
+            }
+        }
+    }
+    bool ok = max_error <= tolerance;
+    std::printf("ramp %-13s K=%-2d : %s (max error %.3g, tolerance %.3g)\n", name, K,
+                ok ? "ok" : "FAILED", max_error, tolerance);
+    return ok;
+}
+
+/**
+ * Envoie 20 cibles toutes les 300 échantillons à un SincDelayTracker dont les
+ * transitions durent 1000 échantillons, puis vérifie le nombre de transitions
+ * (une par cible en file, moins en fusion) et, une fois stabilisé, que la sortie
+ * d'une rampe d'entrée x[n] = n vaut exactement n - dernière cible.
+ * @return true si le suivi se comporte comme attendu.
+ */
+bool checkDelayTracker(TargetPolicy policy, const char* name)
+{
+    const size_t numTargets = 20;
+    const size_t blockSize  = 128;
+
+    SincDelayTracker<double, double> tracker(8192, 500.0, 1000, 2, policy);
+    double                           sample = 0.0;
+    double                           target = 500.0;
+    std::vector<double>              block(blockSize);
+    auto                             runBlock = [&]() {
+        for (double& x : block) {
+            x = sample;
+            sample += 1.0;
+        }
+        tracker.process(block.data(), block.data(), blockSize);
+    };
+
+    size_t sent = 0;
+    for (size_t t = 0; sent < numTargets; t += blockSize) {
+        if (t >= sent * 300) {
+            target = 500.0 + 37.25 * static_cast<double>(sent + 1);
+            tracker.setTarget(target);
+            ++sent;
+        }
+        runBlock();
+    }
+    while (tracker.isTransitioning() || tracker.pendingTargets() > 0) {
+        runBlock();
+    }
+    runBlock();
+
+    double max_error = 0.0;
+    for (size_t i = 0; i < blockSize; ++i) {
+        double expected = sample - static_cast<double>(blockSize - i) - target;
+        max_error       = std::max(max_error, std::abs(block[i] - expected));
+    }
+    size_t transitions = tracker.completedTransitions();
+    bool   ok          = max_error < 1e-6 && tracker.currentDelay() == target &&
+                (policy == TargetPolicy::Queue ? transitions == numTargets
+                                               : transitions < numTargets);
+    std::printf("tracker %-6s : %s (%zu targets, %zu transitions, final delay %.2f, error %.3g)\n",
+                name, ok ? "ok" : "FAILED", numTargets, transitions, tracker.currentDelay(),
+                max_error);
+    return ok;
+}
+
+/**
+ * Vérifie les setters sans exception : rejet ou écrêtage des valeurs hors limites,
+ * NaN toujours rejeté, trySetK limité à la capacité réservée sans table de gains,
+ * délai minimal d'un sinc polyphase à 16 points et setters de la banque.
+ * @return true si chaque statut et chaque valeur appliquée sont ceux attendus.
+ */
+bool checkStatusSetters()
+{
+    using Status = SincDelayStatus;
+
+    MultiTapSincDelay<float, double> line(1024, 1);
+    line.reserveK(4);
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+
+    bool ok = line.trySetTau1(10.5) == Status::Ok && line.trySetTau2(2000.0) == Status::OutOfRange;
+    ok      = ok && line.trySetTau2(2000.0, ParamPolicy::Clamp) == Status::Clamped;
+    ok      = ok && line.trySetTau1(-1.0, ParamPolicy::Clamp) == Status::Clamped;
+    ok      = ok && line.trySetAlpha(nan, ParamPolicy::Clamp) == Status::OutOfRange;
+    ok      = ok && line.trySetAlpha(1.5, ParamPolicy::Clamp) == Status::Clamped;
+    ok      = ok && line.getAlpha() == 1.0;
+    ok      = ok && line.tryRampAlpha(-0.5, 64) == Status::OutOfRange && !line.isRamping();
+    ok      = ok && line.trySetK(4) == Status::Ok && line.getK() == 4;
+    ok      = ok && line.trySetK(5) == Status::InvalidK && line.trySetK(-1) == Status::InvalidK;
+    line.useGainTable();
+    ok = ok && line.trySetK(2) == Status::NotRealtimeSafe && line.getK() == 4;
+
+    // Sinc 16 points : 7 points lus après la position, d'où tau >= 7. Le délai ramené
+    // à 7 est entier : la phase 0 (impulsion unité) rend l'entrée retardée exactement,
+    // même quand tous les taps sont lus
+    MultiTapSincDelay<double, double, -1, PolyphaseSinc16Interpolator> sinc(1024, 1);
+    ok = ok && sinc.minTau() == 7.0 && sinc.trySetTau1(4.5) == Status::OutOfRange;
+    ok = ok && sinc.trySetTau1(4.5, ParamPolicy::Clamp) == Status::Clamped;
+    ok = ok && sinc.trySetTau2(100.0) == Status::Ok;
+    sinc.setPruneThreshold(-1.0);
+    std::vector<double> ramp(512);
+    for (size_t i = 0; i < ramp.size(); ++i) {
+        ramp[i] = static_cast<double>(i);
+    }
+    sinc.process(ramp.data(), ramp.data(), ramp.size());
+    for (size_t i = 7; i < ramp.size(); ++i) {
+        ok = ok && ramp[i] == static_cast<double>(i - 7);
+    }
+
+    // Banque : mêmes statuts, ligne inchangée si une valeur est rejetée
+    MultiTapSincDelayBank<float, double, 8> bank(1024, 1);
+    bank.reserveK(3);
+    ok = ok && bank.trySetDelay(8, 10.0, 20.0, 0.5) == Status::OutOfRange;
+    ok = ok && bank.trySetDelay(0, 10.0, 2000.0, 0.5) == Status::OutOfRange && bank.tau1(0) == 1.0;
+    ok = ok && bank.trySetDelay(0, 10.0, 2000.0, 0.5, ParamPolicy::Clamp) == Status::Clamped;
+    ok = ok && bank.tau1(0) == 10.0 && bank.tau2(0) < 1023.0 && bank.alpha(0) == 0.5;
+    ok = ok && bank.trySetDelay(1, nan, 20.0, 0.5, ParamPolicy::Clamp) == Status::OutOfRange;
+    ok = ok && bank.trySetK(3) == Status::Ok && bank.getK() == 3;
+    ok = ok && bank.trySetK(4) == Status::InvalidK && bank.trySetK(-1) == Status::InvalidK;
+
+    // Délais écrêtés : la ligne doit rester utilisable sur toute la plage
+    std::vector<float> block(512, 1.0f);
+    line.trySetAlpha(0.5);
+    line.process(block.data(), block.data(), block.size());
+    for (float x : block) {
+        ok = ok && std::isfinite(x);
+    }
+    std::printf("status setters : %s\n", ok ? "ok" : "FAILED");
+    return ok;
+}
+
+/**
+ * Vérifie l'élagage des taps sur les trois dispositions : avec le seuil par défaut,
+ * alpha à 0 ou 1 (lecture unique) et alpha quelconque donnent la sortie du calcul
+ * complet (élagage désactivé) aux arrondis près, un seuil positif reste sous la somme
+ * des gains élagués, et les compteurs de taps lus et évités correspondent au nombre
+ * de lectures.
+ * @return true si toutes les sorties et tous les compteurs sont ceux attendus.
+ */
+bool checkTapPruning(int K)
+{
+    const size_t maxDelay  = 8192;
+    const size_t blockSize = 200;
+    const size_t numTaps   = static_cast<size_t>(2 * K + 2);
+    const double threshold = 1e-3;
+
+    std::mt19937                           rng(11);
+    std::uniform_real_distribution<double> noise(-1.0, 1.0);
+    std::vector<double>                    input(blockSize);
+    std::vector<double>                    out_full(blockSize);
+    std::vector<double>                    out(blockSize);
+    std::vector<double>                    out_threshold(blockSize);
+    bool                                   ok        = true;
+    double                                 max_error = 0.0;
+
+    for (BufferLayout layout :
+         {BufferLayout::Modulo, BufferLayout::PowerOfTwo, BufferLayout::Mirrored}) {
+        MultiTapSincDelay<double, double> full(maxDelay, K, 44100.0, layout);
+        MultiTapSincDelay<double, double> pruned(maxDelay, K, 44100.0, layout);
+        MultiTapSincDelay<double, double> coarse(maxDelay, K, 44100.0, layout);
+        full.setPruneThreshold(-1.0);
+        coarse.setPruneThreshold(threshold);
+
+        for (int b = 0; b < 24; ++b) {
+            const double alphas[] = {0.0, 1.0, 0.37};
+            const double alpha    = alphas[b % 3];
+            for (auto* line : {&full, &pruned, &coarse}) {
+                line->setTau1(500.25 + 7.3 * b);
+                line->setTau2(650.5 + 7.3 * b);
+                line->setAlpha(alpha);
+                line->resetTapCounters();
+            }
+            for (double& x : input) {
+                x = noise(rng);
+            }
+            full.process(input.data(), out_full.data(), blockSize);
+            pruned.process(input.data(), out.data(), blockSize);
+            coarse.process(input.data(), out_threshold.data(), blockSize);
+
+            // Borne de l'élagage à seuil : somme des gains élagués (|x| <= 1)
+            std::vector<double> gains(numTaps);
+            sincGains(K, alpha, gains.data());
+            double bound = 1e-10;
+            for (double gain : gains) {
+                bound += (std::abs(gain) <= threshold) ? std::abs(gain) : 0.0;
+            }
+            for (size_t i = 0; i < blockSize; ++i) {
+                double error = std::abs(out[i] - out_full[i]);
+                max_error    = std::max(max_error, error);
+                ok           = ok && error <= 1e-10;
+                ok           = ok && std::abs(out_threshold[i] - out_full[i]) <= bound;
+            }
+
+            // alpha entier : une lecture par échantillon, les autres taps évités
+            const uint64_t reads = (alpha == 0.37) ? numTaps : 1;
+            ok = ok && pruned.tapsRead() == reads * blockSize;
+            ok = ok && pruned.tapsSkipped() == (numTaps - reads) * blockSize;
+            ok = ok && full.tapsRead() == numTaps * blockSize && full.tapsSkipped() == 0;
+            ok = ok && coarse.tapsRead() + coarse.tapsSkipped() == numTaps * blockSize;
+        }
+    }
+    std::printf("tap pruning K=%d : %s (max error %.3g)\n", K, ok ? "ok" : "FAILED", max_error);
+    return ok;
+}
+
+/**
+ * Vérifie le chemin delta entier sur les trois dispositions : un delta entier (une
+ * seule interpolation pour tous les taps) suit le calcul tap par tap d'un delta
+ * décalé de 1e-9, y compris pendant une rampe, et un delta ramené à l'entier par
+ * setDeltaSnapTolerance() donne la sortie du delta entier exact.
+ * @return true si les écarts sont dans les bornes.
+ */
+template <typename INTERP>
+bool checkIntegerDelta(const char* name, int K)
+{
+    using Line = MultiTapSincDelay<double, double, -1, INTERP>;
+
+    const size_t maxDelay  = 8192;
+    const size_t blockSize = 200;
+
+    std::mt19937                           rng(13);
+    std::uniform_real_distribution<double> noise(-1.0, 1.0);
+    std::vector<double>                    input(blockSize);
+    std::vector<double>                    out_integer(blockSize);
+    std::vector<double>                    out_general(blockSize);
+    std::vector<double>                    out_snapped(blockSize);
+    double                                 general_error = 0.0;
+    double                                 snap_error    = 0.0;
+
+    for (BufferLayout layout :
+         {BufferLayout::Modulo, BufferLayout::PowerOfTwo, BufferLayout::Mirrored}) {
+        Line integer(maxDelay, K, 44100.0, layout);
+        Line general(maxDelay, K, 44100.0, layout);
+        Line snapped(maxDelay, K, 44100.0, layout);
+        snapped.setDeltaSnapTolerance(1e-3);
+
+        for (int b = 0; b < 24; ++b) {
+            const double tau1  = 700.3 + 11.7 * b;
+            const double delta = (b % 2 == 0) ? 37.0 : -120.0;
+            integer.setTau1(tau1);
+            integer.setTau2(tau1 + delta);
+            general.setTau1(tau1);
+            general.setTau2(tau1 + delta + 1e-9);
+            snapped.setTau1(tau1);
+            snapped.setTau2(tau1 + delta + 4e-4);
+            for (Line* line : {&integer, &general, &snapped}) {
+                if (b % 3 == 2) {
+                    line->setAlpha(0.0);
+                    line->rampAlpha(1.0, 150);
+                } else {
+                    line->setAlpha(0.29 + 0.01 * b);
+                }
+            }
+            for (double& x : input) {
+                x = noise(rng);
+            }
+            integer.process(input.data(), out_integer.data(), blockSize);
+            general.process(input.data(), out_general.data(), blockSize);
+            snapped.process(input.data(), out_snapped.data(), blockSize);
+            for (size_t i = 0; i < blockSize; ++i) {
+                general_error = std::max(general_error, std::abs(out_integer[i] - out_general[i]));
+                snap_error    = std::max(snap_error, std::abs(out_integer[i] - out_snapped[i]));
+            }
+        }
+    }
+
+    bool ok = general_error <= 1e-6 && snap_error <= 1e-12;
+    std::printf("integer delta %-10s K=%d : %s (error %.3g, snapped error %.3g)\n", name, K,
+                ok ? "ok" : "FAILED", general_error, snap_error);
+    return ok;
+}
+
+/**
+ * Vérifie le traitement par blocs d'un délai fixe sur les trois dispositions, en
+ * place, avec des blocs plus longs que kMaxBlockSize : un délai entier (copie) rend
+ * l'entrée retardée exactement, et un délai fractionnaire (filtre à coefficients
+ * constants) suit la lecture échantillon par échantillon du calcul complet.
+ * @return true si les sorties sont celles attendues.
+ */
+bool checkFixedDelay()
+{
+    const size_t maxDelay  = 3000;  // Ni puissance de deux ni multiple de kMaxBlockSize
+    const size_t blockSize = 700;
+
+    std::mt19937                           rng(17);
+    std::uniform_real_distribution<double> noise(-1.0, 1.0);
+    std::vector<double>                    history;
+    std::vector<double>                    block(blockSize);
+    std::vector<double>                    out_ref(blockSize);
+    bool                                   ok        = true;
+    double                                 max_error = 0.0;
+
+    for (BufferLayout layout :
+         {BufferLayout::Modulo, BufferLayout::PowerOfTwo, BufferLayout::Mirrored}) {
+        for (double delay : {0.0, 3.0, 1000.0, 2998.0, 0.5, 2.25, 1000.37, 2997.5}) {
+            MultiTapSincDelay<double, double> line(maxDelay, 2, 44100.0, layout);
+            MultiTapSincDelay<double, double> ref(maxDelay, 2, 44100.0, BufferLayout::PowerOfTwo);
+            line.setTau1(delay);
+            line.setTau2(delay);
+            ref.setPruneThreshold(-1.0);  // Calcul complet, échantillon par échantillon
+            ref.setTau1(delay);
+            ref.setTau2((delay < 1000.0) ? delay + 0.5 : delay - 0.5);
+            history.clear();
+
+            for (int b = 0; b < 12; ++b) {
+                for (double& x : block) {
+                    x = noise(rng);
+                }
+                history.insert(history.end(), block.begin(), block.end());
+                ref.process(block.data(), out_ref.data(), blockSize);
+                line.process(block.data(), block.data(), blockSize);  // En place
+
+                for (size_t i = 0; i < blockSize; ++i) {
+                    double error = std::abs(block[i] - out_ref[i]);
+                    max_error    = std::max(max_error, error);
+                    ok           = ok && error <= 1e-10;
+                    if (delay == std::floor(delay)) {
+                        size_t t        = static_cast<size_t>(b) * blockSize + i;
+                        size_t d        = static_cast<size_t>(delay);
+                        double expected = (t >= d) ? history[t - d] : 0.0;
+                        ok              = ok && block[i] == expected;
+                    }
+                }
+            }
+        }
+    }
+    std::printf("fixed delay : %s (max error %.3g)\n", ok ? "ok" : "FAILED", max_error);
+    return ok;
+}
+
+/**
+ * Vérifie les lectures à position en virgule fixe 32.32 (readFixed) contre les
+ * lectures en virgule flottante (readInterpolated), sur un buffer Modulo et un buffer
+ * PowerOfTwo remplis de bruit, à des positions et index d'écriture aléatoires.
+ * L'écart vient de l'arrondi de la position à 2^-32 échantillon.
+ * @return true si l'écart est sous la borne.
+ */
+bool checkFixedPositions()
+{
+    const size_t maxDelay = 5000;
+
+    std::mt19937                           rng(19);
+    std::uniform_real_distribution<double> noise(-1.0, 1.0);
+    std::uniform_real_distribution<double> delays(0.0, maxDelay - 2.0);
+    double                                 max_error = 0.0;
+
+    for (BufferLayout layout : {BufferLayout::Modulo, BufferLayout::PowerOfTwo}) {
+        SincDelayBuffer<double> buffer(maxDelay, layout);
+        for (int step = 0; step < 20000; ++step) {
+            double sample = noise(rng);
+            buffer.writeBlock(&sample, 1);
+
+            double tk       = delays(rng);
+            double floating = 0.0;
+            double fixed    = 0.0;
+            if (layout == BufferLayout::Modulo) {
+                floating = buffer.readInterpolated<BufferLayout::Modulo>(
+                    static_cast<double>(buffer.writeIndex()) - tk);
+                fixed = buffer.readFixed<BufferLayout::Modulo>(buffer.fixedOffset(tk));
+            } else {
+                floating = buffer.readInterpolated<BufferLayout::PowerOfTwo>(
+                    static_cast<double>(buffer.writeIndex()) - tk);
+                fixed = buffer.readFixed<BufferLayout::PowerOfTwo>(buffer.fixedOffset(tk));
+            }
+            max_error = std::max(max_error, std::abs(fixed - floating));
+        }
+    }
+
+    // Position arrondie à 2^-33 près, pente de l'interpolation linéaire au plus 2
+    bool ok = max_error <= 2.0 * std::ldexp(1.0, -33) + 1e-12;
+    std::printf("fixed-point positions : %s (max error %.3g)\n", ok ? "ok" : "FAILED", max_error);
+    return ok;
+}
+
+/**
+ * Vérifie une MultiTapSincDelayBank contre LANES lignes MultiTapSincDelay séparées
+ * (disposition Mirrored, interpolation linéaire), pour chaque jeu d'instructions
+ * supporté, avec des paramètres aléatoires par ligne, des lignes à délai fixe et des
+ * blocs de tailles variées.
+ * @return true si l'écart maximal est sous la tolérance.
+ */
+template <typename T, size_t LANES>
+bool checkBank(const char* name, int K, double tolerance)
+{
+    const size_t maxDelay = 8192;
+
+    bool ok = true;
+    for (SimdLevel level : allSimdLevels) {
+        if (!simdSupported(level) || level == SimdLevel::SSE2) {
+            continue;
+        }
+        MultiTapSincDelayBank<T, double, LANES> bank(maxDelay, K);
+        bank.setSimdLevel(level);
+        std::vector<MultiTapSincDelay<T, double>> lines;
+        for (size_t l = 0; l < LANES; ++l) {
+            lines.emplace_back(maxDelay, K, 44100.0, BufferLayout::Mirrored);
+        }
+
+        std::mt19937                           rng(23);
+        std::uniform_real_distribution<double> noise(-1.0, 1.0);
+        std::uniform_real_distribution<double> taus(500.0, 3000.0);
+        std::uniform_real_distribution<double> deltas(-50.0, 50.0);
+        std::uniform_real_distribution<double> alphas(0.0, 1.0);
+        std::uniform_int_distribution<size_t>  sizes(1, 700);
+        std::vector<std::vector<T>>            ins(LANES, std::vector<T>(700));
+        std::vector<std::vector<T>>            outs(LANES, std::vector<T>(700));
+        std::vector<T>                         out_ref(700);
+        std::vector<const T*>                  in_ptrs;
+        std::vector<T*>                        out_ptrs;
+        for (size_t l = 0; l < LANES; ++l) {
+            in_ptrs.push_back(ins[l].data());
+            out_ptrs.push_back(outs[l].data());
+        }
+
+        // Délais multiples de 2^-16, exacts en virgule fixe 32.32 côté lignes
+        auto onGrid = [](double x) { return std::ldexp(std::round(std::ldexp(x, 16)), -16); };
+
+        double max_error = 0.0;
+        for (int b = 0; b < 60; ++b) {
+            const size_t n = sizes(rng);
+            for (size_t l = 0; l < LANES; ++l) {
+                // Une ligne sur trois à délai fixe (tau1 == tau2), alpha fractionnaire compris
+                double tau1  = onGrid(taus(rng));
+                double tau2  = (l % 3 == 0) ? tau1 : tau1 + onGrid(deltas(rng));
+                double alpha = (b % 5 == 0) ? 0.0 : alphas(rng);  // Un tap seul côté lignes
+                bank.setDelay(l, tau1, tau2, alpha);
+                lines[l].setTau1(tau1);
+                lines[l].setTau2(tau2);
+                lines[l].setAlpha(alpha);
+                for (size_t i = 0; i < n; ++i) {
+                    ins[l][i] = static_cast<T>(noise(rng));
+                }
+            }
+            bank.process(in_ptrs.data(), out_ptrs.data(), n);
+            for (size_t l = 0; l < LANES; ++l) {
+                lines[l].process(ins[l].data(), out_ref.data(), n);
+                for (size_t i = 0; i < n; ++i) {
+                    double error = std::abs(static_cast<double>(outs[l][i] - out_ref[i]));
+                    max_error    = std::max(max_error, error);
+                }
+            }
+        }
+
+        bool passed = max_error <= tolerance;
+        ok          = ok && passed;
+        std::printf("bank %-8s K=%-2d lanes=%-2zu %-7s : %s (max error %.3g)\n", name, K, LANES,
+                    simdLevelName(bank.simdLevel()), passed ? "ok" : "FAILED", max_error);
+    }
+    return ok;
+}
+
+/**
+ * Vérifie une politique d'interpolation : les trois dispositions (poids appliqués par
+ * les noyaux tap par tap ou interpolate() échantillon par échantillon) donnent la même
+ * sortie, et un sinus retardé d'un délai fractionnaire fixe est reproduit avec une
+ * erreur inférieure à sine_bound (précision de l'interpolateur à 0.1 * fs), y compris
+ * au plus petit délai accepté (minTau).
+ * @return true si les vérifications passent.
+ */
+template <typename INTERP>
+bool checkInterpolator(const char* name, double sine_bound)
+{
+    using Line = MultiTapSincDelay<double, double, -1, INTERP>;
+
+    const size_t maxDelay  = 8192;
+    const size_t blockSize = 300;
+
+    Line ref(maxDelay, 2, 44100.0, BufferLayout::PowerOfTwo);
+    Line modulo(maxDelay, 2, 44100.0, BufferLayout::Modulo);
+    Line mirrored(maxDelay, 2, 44100.0, BufferLayout::Mirrored);
+
+    std::mt19937                           rng(9);
+    std::uniform_real_distribution<double> noise(-1.0, 1.0);
+    std::vector<double>                    input(blockSize);
+    std::vector<double>                    out_ref(blockSize);
+    std::vector<double>                    out(blockSize);
+    double                                 layout_error = 0.0;
+    for (int b = 0; b < 30; ++b) {
+        for (Line* line : {&ref, &modulo, &mirrored}) {
+            line->setTau1(1000.25 + 3.1 * b);
+            line->setTau2(1030.5 + 3.1 * b);
+            line->setAlpha(static_cast<double>(b) / 29.0);
+        }
+        for (double& x : input) {
+            x = noise(rng);
+        }
+        ref.process(input.data(), out_ref.data(), blockSize);
+        for (Line* line : {&modulo, &mirrored}) {
+            line->process(input.data(), out.data(), blockSize);
+            for (size_t i = 0; i < blockSize; ++i) {
+                layout_error = std::max(layout_error, std::abs(out[i] - out_ref[i]));
+            }
+        }
+    }
+
+    // Sinus à 0.1 * fs, délai fixe fractionnaire
+    const double frequency = 0.1;
+    auto         sineError = [&](Line& line, double delay) {
+        line.setTau1(delay);
+        line.setTau2(delay);
+        double error = 0.0;
+        for (size_t start = 0; start < 4096; start += blockSize) {
+            for (size_t i = 0; i < blockSize; ++i) {
+                input[i] = std::sin(2.0 * M_PI * frequency * static_cast<double>(start + i));
+            }
+            line.process(input.data(), out.data(), blockSize);
+            for (size_t i = 0; i < blockSize; ++i) {
+                double t = static_cast<double>(start + i) - delay;
+                if (t > 10.0) {
+                    double expected = std::sin(2.0 * M_PI * frequency * t);
+                    error           = std::max(error, std::abs(out[i] - expected));
+                }
+            }
+        }
+        return error;
+    };
+    Line   line(maxDelay, 2, 44100.0, BufferLayout::Mirrored);
+    double sine_error = sineError(line, 200.37);
+
+    // Petit délai juste au-dessus de minTau() : les points lus après la position
+    // s'arrêtent à l'échantillon courant, sur les trois dispositions. En dessous, le
+    // délai est refusé ou ramené à minTau()
+    const double min_tau   = line.minTau();
+    bool         bounds_ok = line.trySetTau1(min_tau - 0.5) == SincDelayStatus::OutOfRange;
+    bounds_ok = bounds_ok && line.trySetTau2(min_tau - 0.5, ParamPolicy::Clamp) ==
+                                 SincDelayStatus::Clamped;
+    double small_error = 0.0;
+    for (BufferLayout layout :
+         {BufferLayout::Modulo, BufferLayout::PowerOfTwo, BufferLayout::Mirrored}) {
+        Line small(maxDelay, 2, 44100.0, layout);
+        small_error = std::max(small_error, sineError(small, min_tau + 0.37));
+    }
+
+    bool ok = layout_error <= 1e-10 && sine_error <= sine_bound && bounds_ok &&
+              small_error <= sine_bound;
+    std::printf("interp %-10s : %s (%d points, layout error %.3g, sine error %.3g, small delay "
+                "error %.3g, bound %.3g)\n",
+                name, ok ? "ok" : "FAILED", INTERP::kPoints, layout_error, sine_error, small_error,
+                sine_bound);
+    return ok;
+}
+
+/**
+ * Mesure le temps par échantillon (en ns) d'une banque de lignes avec une politique
+ * d'interpolation donnée, pour comparer qualité et coût (voir checkInterpolator).
+ */
+template <typename INTERP>
+void benchInterpolator(const char* name, int K, BufferLayout layout, size_t numLines,
+                       size_t blockSize, size_t numBlocks)
+{
+    const size_t maxDelay = 1 << 16;
+
+    std::vector<MultiTapSincDelay<float, double, -1, INTERP>> lines;
+    for (size_t l = 0; l < numLines; ++l) {
+        lines.emplace_back(maxDelay, K, 44100.0, layout);
+        lines.back().setTau1(100.5 + static_cast<double>(l));
+        lines.back().setTau2(5000.7 + static_cast<double>(l));
+    }
+
+    std::mt19937                          rng(1);
+    std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+    std::vector<float>                    input(blockSize);
+    std::vector<float>                    output(blockSize);
+    for (float& sample : input) {
+        sample = noise(rng);
+    }
+
+    double best = 1e300;
+    for (int pass = 0; pass < 5; ++pass) {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t b = 0; b < numBlocks; ++b) {
+            double alpha = static_cast<double>(b % 100) / 99.0;
+            for (auto& line : lines) {
+                line.setAlpha(alpha);
+                line.process(input.data(), output.data(), blockSize);
+            }
+        }
+        auto   stop = std::chrono::steady_clock::now();
+        double ns   = std::chrono::duration<double, std::nano>(stop - start).count();
+        best        = std::min(best, ns);
+    }
+
+    double samples = static_cast<double>(numLines * blockSize * numBlocks);
+    std::printf("interp %-10s K=%-2d %-10s cost/tap=%-2d weights=%-3d : %8.2f ns/sample\n", name,
+                K, (layout == BufferLayout::Mirrored) ? "mirrored" : "pow2", INTERP::kCostPerTap,
+                INTERP::kWeightCost, best / samples);
+}
+
+/**
+ * Mesure le temps par échantillon et par ligne (en ns) d'une MultiTapSincDelayBank,
+ * comparé à autant de lignes MultiTapSincDelay séparées (disposition Mirrored).
+ */
+template <typename T, size_t LANES>
+void benchBank(const char* name, int K, size_t numLines, size_t blockSize, size_t numBlocks)
+{
+    const size_t maxDelay = 1 << 16;
+    const size_t numBanks = numLines / LANES;
+
+    std::vector<MultiTapSincDelayBank<T, double, LANES>> banks;
+    std::vector<MultiTapSincDelay<T, double>>            lines;
+    for (size_t l = 0; l < numBanks * LANES; ++l) {
+        if (l % LANES == 0) {
+            banks.emplace_back(maxDelay, K);
+        }
+        lines.emplace_back(maxDelay, K, 44100.0, BufferLayout::Mirrored);
+    }
+
+    std::mt19937                      rng(1);
+    std::uniform_real_distribution<T> noise(T(-1), T(1));
+    std::vector<T>                    input(blockSize);
+    std::vector<std::vector<T>>       outs(LANES, std::vector<T>(blockSize));
+    std::vector<const T*>             in_ptrs(LANES, input.data());
+    std::vector<T*>                   out_ptrs;
+    for (T& sample : input) {
+        sample = noise(rng);
+    }
+    for (auto& out : outs) {
+        out_ptrs.push_back(out.data());
+    }
+
+    double best_bank  = 1e300;
+    double best_lines = 1e300;
+    for (int pass = 0; pass < 5; ++pass) {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t b = 0; b < numBlocks; ++b) {
+            double alpha = static_cast<double>(b % 100) / 99.0;
+            for (size_t l = 0; l < lines.size(); ++l) {
+                double tau1 = 100.5 + static_cast<double>(l);
+                banks[l / LANES].setDelay(l % LANES, tau1, tau1 + 4900.2, alpha);
+            }
+            for (auto& bank : banks) {
+                bank.process(in_ptrs.data(), out_ptrs.data(), blockSize);
+            }
+        }
+        auto   stop = std::chrono::steady_clock::now();
+        double ns   = std::chrono::duration<double, std::nano>(stop - start).count();
+        best_bank   = std::min(best_bank, ns);
+
+        start = std::chrono::steady_clock::now();
+        for (size_t b = 0; b < numBlocks; ++b) {
+            double alpha = static_cast<double>(b % 100) / 99.0;
+            for (size_t l = 0; l < lines.size(); ++l) {
+                double tau1 = 100.5 + static_cast<double>(l);
+                lines[l].setTau1(tau1);
+                lines[l].setTau2(tau1 + 4900.2);
+                lines[l].setAlpha(alpha);
+                lines[l].process(input.data(), outs[0].data(), blockSize);
+            }
+        }
+        stop       = std::chrono::steady_clock::now();
+        ns         = std::chrono::duration<double, std::nano>(stop - start).count();
+        best_lines = std::min(best_lines, ns);
+    }
+
+    double samples = static_cast<double>(lines.size() * blockSize * numBlocks);
+    std::printf("%-14s K=%-2d bank lanes=%-2zu lines=%zu block=%-3zu : %8.2f ns/sample/line "
+                "(separate %.2f)\n",
+                name, K, LANES, lines.size(), blockSize, best_bank / samples, best_lines / samples);
+}
+
+int main()
+{
+    const size_t numLines  = 64;
+    const size_t blockSize = 256;
+    const size_t numBlocks = 200;
+
+    bool ok = checkTapKernels<double>("double");
+    ok      = checkTapKernels<float>("float") && ok;
+    for (int K : {0, 2, 8}) {
+        ok = checkProcessKernels<double, double>("double/double", K) && ok;
+        ok = checkProcessKernels<float, double>("float/double", K) && ok;
+        ok = checkRenderMatrix<double, double>("double/double", K) && ok;
+        ok = checkRenderMatrix<float, double>("float/double", K) && ok;
+        ok = checkParallelBank<float, double>("float/double", K) && ok;
+        ok = checkAlphaRamp<double, double>("double/double", K, 1e-11) && ok;
+        ok = checkAlphaRamp<float, double>("float/double", K, 1e-5) && ok;
+    }
+    ok = checkParameterMailbox() && ok;
+    ok = checkDelayTracker(TargetPolicy::Queue, "queue") && ok;
+    ok = checkDelayTracker(TargetPolicy::Merge, "merge") && ok;
+    ok = checkStatusSetters() && ok;
+    ok = checkFixedDelay() && ok;
+    ok = checkFixedPositions() && ok;
+    for (int K : {0, 1, 2}) {
+        ok = checkBank<double, 8>("double", K, 1e-12) && ok;
+        ok = checkBank<float, 8>("float", K, 1e-5) && ok;
+        ok = checkBank<float, 16>("float", K, 1e-5) && ok;
+    }
+    for (int K : {0, 2, 8}) {
+        ok = checkTapPruning(K) && ok;
+        ok = checkIntegerDelta<LinearInterpolator>("linear", K) && ok;
+        ok = checkIntegerDelta<Lagrange4Interpolator>("lagrange4", K) && ok;
+    }
+    ok = checkInterpolator<LinearInterpolator>("linear", 0.06) && ok;
+    ok = checkInterpolator<Lagrange4Interpolator>("lagrange4", 5e-3) && ok;
+    ok = checkInterpolator<Hermite4Interpolator>("hermite4", 6e-3) && ok;
+    ok = checkInterpolator<Lagrange6Interpolator>("lagrange6", 5e-4) && ok;
+    ok = checkInterpolator<FarrowInterpolator<>>("farrow4", 5e-3) && ok;
+    ok = checkInterpolator<PolyphaseSinc8Interpolator>("sinc8", 1e-3) && ok;
+    ok = checkInterpolator<PolyphaseSinc16Interpolator>("sinc16", 1e-4) && ok;
+    if (!ok) {
+        std::printf("Correctness check FAILED\n");
+        return 1;
+    }
+    std::printf("Detected SIMD level: %s\n", simdLevelName(detectSimdLevel()));
+
+    for (int K : {0, 2, 8}) {
+        for (BufferLayout layout : {BufferLayout::PowerOfTwo, BufferLayout::Mirrored}) {
+            for (bool fixedK : {false, true}) {
+                benchThroughput<double, double>("double/double", K, fixedK, layout, numLines,
+                                                blockSize, numBlocks);
+                benchThroughput<float, double>("float/double", K, fixedK, layout, numLines,
+                                               blockSize, numBlocks);
+                benchThroughput<float, float>("float/float", K, fixedK, layout, numLines,
+                                              blockSize, numBlocks);
+            }
+        }
+    }
+
+    for (int K : {0, 2}) {
+        benchRenderMatrix<float, double>("float/double", K, 16, 32, blockSize, 50);
+    }
+
+    const size_t maxThreads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    for (size_t threads = 1; threads <= maxThreads; threads *= 2) {
+        benchParallelBank<float, double>("float/double", 2, 300, threads, blockSize, 50);
+    }
+
+    for (int K : {0, 1}) {
+        for (size_t size : {size_t(32), blockSize}) {
+            benchBank<float, 8>("float/double", K, numLines, size, numBlocks * blockSize / size);
+            benchBank<float, 16>("float/double", K, numLines, size, numBlocks * blockSize / size);
+        }
+    }
+
+    for (BufferLayout layout : {BufferLayout::PowerOfTwo, BufferLayout::Mirrored}) {
+        benchInterpolator<LinearInterpolator>("linear", 2, layout, numLines, blockSize, numBlocks);
+        benchInterpolator<Lagrange4Interpolator>("lagrange4", 2, layout, numLines, blockSize,
+                                                 numBlocks);
+        benchInterpolator<Hermite4Interpolator>("hermite4", 2, layout, numLines, blockSize,
+                                                numBlocks);
+        benchInterpolator<Lagrange6Interpolator>("lagrange6", 2, layout, numLines, blockSize,
+                                                 numBlocks);
+        benchInterpolator<FarrowInterpolator<>>("farrow4", 2, layout, numLines, blockSize,
+                                                numBlocks);
+        benchInterpolator<PolyphaseSinc8Interpolator>("sinc8", 2, layout, numLines, blockSize,
+                                                      numBlocks);
+        benchInterpolator<PolyphaseSinc16Interpolator>("sinc16", 2, layout, numLines, blockSize,
+                                                       numBlocks);
+    }
+    return 0;
+}
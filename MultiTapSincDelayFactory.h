@@ -0,0 +1,110 @@
+/************************************************************************
+ Choix à l'exécution d'un MultiTapSincDelay à K fixé à la compilation.
+ ************************************************************************/
+
+#ifndef MULTI_TAP_SINC_DELAY_FACTORY_H
+#define MULTI_TAP_SINC_DELAY_FACTORY_H
+
+#include <array>
+#include <memory>
+#include <stdexcept>
+#include <utility>  // Pour std::integer_sequence
+
+#include "MultiTapSincDelay.h"
+
+/**
+ * Interface commune aux lignes à retard de K différents créées par
+ * makeMultiTapSincDelay(). Le coût est d'un appel virtuel par bloc.
+ */
+template <typename T = double, typename P = double>
+class MultiTapSincDelayInterface {
+   public:
+    virtual ~MultiTapSincDelayInterface() {}
+
+    virtual int  getK() const                            = 0;
+    virtual void setTau1(P newTau1)                      = 0;
+    virtual void setTau2(P newTau2)                      = 0;
+    virtual void setAlpha(P newAlpha)                    = 0;
+    virtual void useGainTable(size_t resolution)         = 0;
+    virtual T    process(T inputSample)                  = 0;
+    virtual void process(const T* in, T* out, size_t n)  = 0;
+};
+
+/**
+ * Implémentation de MultiTapSincDelayInterface par un MultiTapSincDelay<T, P, FIXED_K>.
+ */
+template <typename T, typename P, int FIXED_K>
+class MultiTapSincDelayAdapter : public MultiTapSincDelayInterface<T, P> {
+   public:
+    MultiTapSincDelayAdapter(size_t max_delay_samples, int K, P sample_rate, BufferLayout layout)
+        : m_delay(max_delay_samples, K, sample_rate, layout)
+    {
+    }
+
+    int  getK() const override { return m_delay.getK(); }
+    void setTau1(P newTau1) override { m_delay.setTau1(newTau1); }
+    void setTau2(P newTau2) override { m_delay.setTau2(newTau2); }
+    void setAlpha(P newAlpha) override { m_delay.setAlpha(newAlpha); }
+    void useGainTable(size_t resolution) override { m_delay.useGainTable(resolution); }
+    T    process(T inputSample) override { return m_delay.process(inputSample); }
+    void process(const T* in, T* out, size_t n) override { m_delay.process(in, out, n); }
+
+   private:
+    MultiTapSincDelay<T, P, FIXED_K> m_delay;
+};
+
+/**
+ * Plus grande valeur de K disposant d'une spécialisation à la compilation.
+ */
+static constexpr int kMaxFixedK = 16;
+
+namespace detail {
+
+template <typename T, typename P>
+using MultiTapSincDelayCreator = std::unique_ptr<MultiTapSincDelayInterface<T, P>> (*)(size_t, P,
+                                                                                      BufferLayout);
+
+template <typename T, typename P, int FIXED_K>
+std::unique_ptr<MultiTapSincDelayInterface<T, P>> createFixedK(size_t max_delay_samples,
+                                                               P sample_rate, BufferLayout layout)
+{
+    return std::unique_ptr<MultiTapSincDelayInterface<T, P>>(
+        new MultiTapSincDelayAdapter<T, P, FIXED_K>(max_delay_samples, FIXED_K, sample_rate,
+                                                    layout));
+}
+
+template <typename T, typename P, int... Ks>
+constexpr std::array<MultiTapSincDelayCreator<T, P>, sizeof...(Ks)> makeDispatchTable(
+    std::integer_sequence<int, Ks...>)
+{
+    return {{&createFixedK<T, P, Ks>...}};
+}
+
+}  // namespace detail
+
+/**
+ * Crée une ligne à retard pour un K choisi à l'exécution. Pour 0 <= K <= kMaxFixedK,
+ * une table de dispatch sélectionne la spécialisation MultiTapSincDelay<T, P, K>
+ * correspondante ; au-delà, K reste dynamique.
+ * @param max_delay_samples Taille maximale du buffer de délai en échantillons.
+ * @param K Le nombre de paires de taps auxiliaires.
+ */
+template <typename T = double, typename P = double>
+std::unique_ptr<MultiTapSincDelayInterface<T, P>> makeMultiTapSincDelay(
+    size_t max_delay_samples, int K, P sample_rate = 44100.0,
+    BufferLayout layout = BufferLayout::Modulo)
+{
+    static constexpr auto table =
+        detail::makeDispatchTable<T, P>(std::make_integer_sequence<int, kMaxFixedK + 1>());
+
+    if (K < 0) {
+        MTSD_THROW(std::invalid_argument, "K cannot be negative.");
+    }
+    if (K <= kMaxFixedK) {
+        return table[static_cast<size_t>(K)](max_delay_samples, sample_rate, layout);
+    }
+    return std::unique_ptr<MultiTapSincDelayInterface<T, P>>(
+        new MultiTapSincDelayAdapter<T, P, -1>(max_delay_samples, K, sample_rate, layout));
+}
+
+#endif  // MULTI_TAP_SINC_DELAY_FACTORY_H
@@ -0,0 +1,319 @@
+/************************************************************************
+ Politiques d'interpolation fractionnaire des lectures de MultiTapSincDelay :
+ linéaire, Lagrange, Hermite et structure de Farrow.
+ ************************************************************************/
+
+#ifndef MULTI_TAP_SINC_DELAY_INTERPOLATORS_H
+#define MULTI_TAP_SINC_DELAY_INTERPOLATORS_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+/**
+ * Une politique d'interpolation lit kPoints échantillons consécutifs autour de la
+ * position fractionnaire index + frac (0 <= frac < 1) : les points x[0..kPoints-1]
+ * sont aux index index - kOrigin .. index - kOrigin + kPoints - 1, avec
+ * kOrigin = kPoints / 2 - 1 (index et index + 1 encadrent la position).
+ *
+ * Chaque politique fournit :
+ * - weights(frac, w) : les kPoints poids, appliqués par les noyaux SIMD tap par tap
+ *   (TapKernel à kPoints coefficients, voir MultiTapSincDelaySimd.h), où frac est
+ *   constant sur un sous-bloc et les poids calculés une fois par sous-bloc ;
+ * - interpolate(x, frac) : la lecture d'un échantillon (dispositions Modulo et
+ *   PowerOfTwo, poids recalculés à chaque échantillon) ;
+ * - kCostPerTap : le nombre de multiplications-additions par échantillon et par tap
+ *   du noyau tap par tap, et kWeightCost le nombre d'opérations du calcul des poids.
+ */
+
+/**
+ * Interpolation linéaire (2 points). Atténue le haut du spectre (-3 dB à la moitié
+ * de la fréquence de Nyquist pour frac = 0.5).
+ */
+struct LinearInterpolator {
+    static constexpr int kPoints     = 2;
+    static constexpr int kOrigin     = 0;
+    static constexpr int kCostPerTap = 2;
+    static constexpr int kWeightCost = 1;
+
+    template <typename T>
+    static void weights(T frac, T* w)
+    {
+        w[0] = T(1) - frac;
+        w[1] = frac;
+    }
+
+    template <typename T>
+    static T interpolate(const T* x, T frac)
+    {
+        return x[0] * (T(1) - frac) + x[1] * frac;
+    }
+};
+
+/**
+ * Interpolation de Lagrange à N points (ordre N - 1), N pair.
+ * Les poids w[j] = prod_{m != j} (d - m) / (j - m), avec d = frac + kOrigin, sont
+ * calculés par produits préfixes et suffixes en O(N).
+ */
+template <int N>
+struct LagrangeInterpolator {
+    static_assert(N >= 2 && N % 2 == 0, "Lagrange interpolation needs an even number of points.");
+
+    static constexpr int kPoints     = N;
+    static constexpr int kOrigin     = N / 2 - 1;
+    static constexpr int kCostPerTap = N;
+    static constexpr int kWeightCost = 4 * N;
+
+    template <typename T>
+    static void weights(T frac, T* w)
+    {
+        const T d = frac + T(kOrigin);
+
+        // w[j] reçoit d'abord le produit préfixe prod_{m < j} (d - m)
+        T prefix = T(1);
+        for (int j = 0; j < N; ++j) {
+            w[j] = prefix;
+            prefix *= d - T(j);
+        }
+        T suffix = T(1);
+        for (int j = N - 1; j >= 0; --j) {
+            w[j] *= suffix * T(inverseDenominator(j));
+            suffix *= d - T(j);
+        }
+    }
+
+    template <typename T>
+    static T interpolate(const T* x, T frac)
+    {
+        T w[N];
+        weights(frac, w);
+        T sum = T(0);
+        for (int p = 0; p < N; ++p) {
+            sum += w[p] * x[p];
+        }
+        return sum;
+    }
+
+   private:
+    /**
+     * 1 / prod_{m != j} (j - m) = (-1)^(N-1-j) / (j! (N-1-j)!).
+     */
+    static constexpr double inverseDenominator(int j)
+    {
+        double denominator = 1.0;
+        for (int m = 0; m < N; ++m) {
+            if (m != j) {
+                denominator *= static_cast<double>(j - m);
+            }
+        }
+        return 1.0 / denominator;
+    }
+};
+
+using Lagrange4Interpolator = LagrangeInterpolator<4>;
+using Lagrange6Interpolator = LagrangeInterpolator<6>;
+
+/**
+ * Interpolation d'Hermite cubique à 4 points (spline de Catmull-Rom) : continue en
+ * dérivée, moins d'ondulation que Lagrange 4 points pour un coût équivalent.
+ */
+struct Hermite4Interpolator {
+    static constexpr int kPoints     = 4;
+    static constexpr int kOrigin     = 1;
+    static constexpr int kCostPerTap = 4;
+    static constexpr int kWeightCost = 12;
+
+    template <typename T>
+    static void weights(T frac, T* w)
+    {
+        const T d  = frac;
+        const T d2 = d * d;
+        const T d3 = d2 * d;
+        w[0]       = T(0.5) * (-d3 + T(2) * d2 - d);
+        w[1]       = T(0.5) * (T(3) * d3 - T(5) * d2) + T(1);
+        w[2]       = T(0.5) * (T(-3) * d3 + T(4) * d2 + d);
+        w[3]       = T(0.5) * (d3 - d2);
+    }
+
+    template <typename T>
+    static T interpolate(const T* x, T frac)
+    {
+        // Forme polynomiale : 3 branches à coefficients constants puis Horner
+        const T c1 = T(0.5) * (x[2] - x[0]);
+        const T c2 = x[0] - T(2.5) * x[1] + T(2) * x[2] - T(0.5) * x[3];
+        const T c3 = T(0.5) * (x[3] - x[0]) + T(1.5) * (x[1] - x[2]);
+        return ((c3 * frac + c2) * frac + c1) * frac + x[1];
+    }
+};
+
+/**
+ * Coefficients de Farrow de l'interpolation de Lagrange cubique à 4 points :
+ * y = sum_m frac^m * sum_p kMatrix[m][p] * x[p].
+ */
+struct FarrowLagrange4Coeffs {
+    static constexpr int    kPoints                      = 4;
+    static constexpr int    kOrder                       = 3;
+    static constexpr double kMatrix[kOrder + 1][kPoints] = {
+        {0.0, 1.0, 0.0, 0.0},
+        {-1.0 / 3.0, -0.5, 1.0, -1.0 / 6.0},
+        {0.5, -1.0, 0.5, 0.0},
+        {-1.0 / 6.0, 0.5, -0.5, 1.0 / 6.0},
+    };
+};
+
+/**
+ * Structure de Farrow : kOrder + 1 filtres à coefficients constants sur les points
+ * (les branches), combinés par un schéma de Horner en frac. Le coût par échantillon
+ * ne dépend pas du calcul de poids, ce qui convient quand frac change à chaque
+ * échantillon ; la matrice (COEFFS::kMatrix) peut être remplacée par un jeu optimisé
+ * pour une bande passante donnée.
+ * @param COEFFS La matrice de Farrow (voir FarrowLagrange4Coeffs).
+ */
+template <typename COEFFS = FarrowLagrange4Coeffs>
+struct FarrowInterpolator {
+    static constexpr int kPoints     = COEFFS::kPoints;
+    static constexpr int kOrigin     = kPoints / 2 - 1;
+    static constexpr int kCostPerTap = kPoints;
+    static constexpr int kWeightCost = 2 * COEFFS::kOrder * kPoints;
+
+    template <typename T>
+    static void weights(T frac, T* w)
+    {
+        for (int p = 0; p < kPoints; ++p) {
+            T weight = T(COEFFS::kMatrix[COEFFS::kOrder][p]);
+            for (int m = COEFFS::kOrder - 1; m >= 0; --m) {
+                weight = weight * frac + T(COEFFS::kMatrix[m][p]);
+            }
+            w[p] = weight;
+        }
+    }
+
+    template <typename T>
+    static T interpolate(const T* x, T frac)
+    {
+        T sum = T(0);
+        for (int m = COEFFS::kOrder; m >= 0; --m) {
+            T branch = T(0);
+            for (int p = 0; p < kPoints; ++p) {
+                branch += T(COEFFS::kMatrix[m][p]) * x[p];
+            }
+            sum = sum * frac + branch;
+        }
+        return sum;
+    }
+};
+
+/**
+ * Sinc fenêtré (fenêtre de Kaiser) à N points lu dans une table polyphase de PHASES
+ * phases, calculée une fois et partagée par toutes les instances : la phase est
+ * choisie d'après frac et les poids sont interpolés linéairement entre deux phases
+ * voisines, puis appliqués par un produit scalaire de N points (noyaux SIMD tap par
+ * tap, ou boucle de longueur constante vectorisée par le compilateur).
+ * Chaque phase est normalisée à un gain unitaire en continu ; la phase 0 est
+ * l'impulsion unité, un délai entier est donc restitué exactement.
+ * Les N / 2 points lus après la position limitent le délai à N / 2 - 1 au moins
+ * (7 pour 16 points, voir SincTapReader::minTau).
+ * @param N Le nombre de points (pair), 8 ou 16 typiquement.
+ * @param PHASES Le nombre de phases de la table.
+ */
+template <int N, int PHASES = 256>
+struct PolyphaseSincInterpolator {
+    static_assert(N >= 2 && N % 2 == 0, "Polyphase sinc needs an even number of points.");
+
+    static constexpr int    kPoints     = N;
+    static constexpr int    kOrigin     = N / 2 - 1;
+    static constexpr int    kCostPerTap = N;
+    static constexpr int    kWeightCost = 2 * N;
+    static constexpr double kBeta       = 8.0;  // Paramètre de la fenêtre de Kaiser
+
+    template <typename T>
+    static void weights(T frac, T* w)
+    {
+        T   position = frac * T(PHASES);
+        int phase    = static_cast<int>(position);
+        if (phase >= PHASES) {  // frac arrondi à 1 en float
+            phase = PHASES - 1;
+        }
+        const T  blend = position - T(phase);
+        const T* row0  = table<T>() + static_cast<size_t>(phase) * N;
+        const T* row1  = row0 + N;
+        for (int p = 0; p < N; ++p) {
+            w[p] = row0[p] + blend * (row1[p] - row0[p]);
+        }
+    }
+
+    template <typename T>
+    static T interpolate(const T* x, T frac)
+    {
+        T w[N];
+        weights(frac, w);
+        T sum = T(0);
+        for (int p = 0; p < N; ++p) {
+            sum += w[p] * x[p];
+        }
+        return sum;
+    }
+
+    /**
+     * Retourne la table partagée : PHASES + 1 lignes de N poids, la ligne ph pour
+     * frac = ph / PHASES (la dernière, frac = 1, sert à l'interpolation entre phases).
+     * Le premier appel construit la table (allocation) : l'appeler une fois hors du
+     * thread audio.
+     */
+    template <typename T>
+    static const T* table()
+    {
+        static const std::vector<T> coefficients = makeTable<T>();
+        return coefficients.data();
+    }
+
+   private:
+    /**
+     * Fonction de Bessel modifiée de première espèce d'ordre 0 (série entière).
+     */
+    static double besselI0(double x)
+    {
+        double sum  = 1.0;
+        double term = 1.0;
+        for (int k = 1; k < 50 && term > 1e-20 * sum; ++k) {
+            double half = x / (2.0 * k);
+            term *= half * half;
+            sum += term;
+        }
+        return sum;
+    }
+
+    template <typename T>
+    static std::vector<T> makeTable()
+    {
+        const double pi = 3.14159265358979323846;
+        std::vector<T> coefficients(static_cast<size_t>(PHASES + 1) * N);
+        for (int phase = 0; phase <= PHASES; ++phase) {
+            const double frac = static_cast<double>(phase) / PHASES;
+            double       row[N];
+            double       sum = 0.0;
+            for (int p = 0; p < N; ++p) {
+                // Distance du point p à la position lue, dans [-N/2, N/2] ; sin(pi * t)
+                // n'est pas exactement nul aux entiers, le sinc y est forcé à 0
+                double t      = static_cast<double>(p - kOrigin) - frac;
+                double sinc   = (t == std::round(t)) ? ((t == 0.0) ? 1.0 : 0.0)
+                                                     : std::sin(pi * t) / (pi * t);
+                double ratio  = t / (N / 2.0);
+                double window = besselI0(kBeta * std::sqrt(std::max(0.0, 1.0 - ratio * ratio))) /
+                                besselI0(kBeta);
+                row[p] = sinc * window;
+                sum += row[p];
+            }
+            for (int p = 0; p < N; ++p) {
+                coefficients[static_cast<size_t>(phase) * N + p] = static_cast<T>(row[p] / sum);
+            }
+        }
+        return coefficients;
+    }
+};
+
+using PolyphaseSinc8Interpolator  = PolyphaseSincInterpolator<8>;
+using PolyphaseSinc16Interpolator = PolyphaseSincInterpolator<16>;
+
+#endif  // MULTI_TAP_SINC_DELAY_INTERPOLATORS_H
@@ -0,0 +1,561 @@
+/************************************************************************
+ Noyaux SIMD de MultiTapSincDelay, choisis à l'exécution selon le CPU.
+ ************************************************************************/
+
+#ifndef MULTI_TAP_SINC_DELAY_SIMD_H
+#define MULTI_TAP_SINC_DELAY_SIMD_H
+
+#include <cstddef>  // Pour size_t
+#include <cstdint>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define MTSD_X86_SIMD 1
+#include <immintrin.h>
+#define MTSD_TARGET(isa) __attribute__((target(isa)))
+#else
+#define MTSD_X86_SIMD 0
+#endif
+
+/**
+ * Jeux d'instructions disponibles pour les noyaux, du moins au plus large.
+ */
+enum class SimdLevel {
+    Scalar,  // Boucle C++ portable (repli)
+    SSE2,    // 2 double / 4 float par vecteur
+    AVX2,    // AVX2 + FMA : 4 double / 8 float par vecteur
+    AVX512   // AVX-512F : 8 double / 16 float par vecteur
+};
+
+/**
+ * Noyau d'accumulation d'un tap sur un sous-bloc :
+ * acc[i] += coeffs[0] * src[i] + ... + coeffs[points-1] * src[i+points-1], pour 0 <= i < n.
+ * Le gain du tap est inclus dans les coefficients d'interpolation (constants sur le
+ * sous-bloc), src désigne une plage contiguë de n + points - 1 échantillons.
+ */
+template <typename T>
+using TapKernel = void (*)(T* acc, const T* src, const T* coeffs, int points, size_t n);
+
+/**
+ * Noyau d'accumulation d'un tap à gain variable (rampe de alpha) :
+ * acc[i] += gains[i] * (coeffs[0] * src[i] + ... + coeffs[points-1] * src[i+points-1]).
+ * Les coefficients d'interpolation restent constants sur le sous-bloc, le gain du tap
+ * est donné échantillon par échantillon.
+ */
+template <typename T>
+using ModulatedTapKernel = void (*)(T* acc, const T* src, const T* coeffs, const T* gains,
+                                    int points, size_t n);
+
+/**
+ * Noyau de lecture d'une banque de lignes entrelacées (voir MultiTapSincDelayBank) :
+ * l'échantillon d'index r de la ligne l est rangé dans history[r * lanes + l], et
+ * chaque voie SIMD traite une ligne. Pour 0 <= i < n et 0 <= l < lanes :
+ * out[i * lanes + l] = sum_k c0[k * lanes + l] * history[j0] + c1[k * lanes + l] * history[j1],
+ * avec j0 = (start + i * lanes + offsets[k * lanes + l]) & mask et j1 = (j0 + lanes) & mask.
+ * Les offsets sont déjà multipliés par lanes et incluent la voie l, start est l'index
+ * de la première trame multiplié par lanes, et mask + 1 (la taille de history, une
+ * puissance de deux) tient sur un int32. Les positions diffèrent d'une ligne à
+ * l'autre : les lectures sont des gathers.
+ */
+template <typename T>
+using BankKernel = void (*)(T* out, const T* history, const uint32_t* offsets, const T* c0,
+                            const T* c1, int num_taps, int lanes, uint32_t start, uint32_t mask,
+                            size_t n);
+
+/**
+ * Tolérance des noyaux SIMD par rapport au noyau scalaire : l'écart absolu sur
+ * acc[i] est borné par simdTolerance<T>() * sum(|coeffs[p] * src[i+p]|) pour un
+ * tap, les sommes sur plusieurs taps cumulant les écarts. Les écarts viennent du
+ * FMA (arrondi unique) et ne dépendent pas de l'ordre des taps.
+ */
+template <typename T>
+constexpr T simdTolerance()
+{
+    return sizeof(T) == sizeof(float) ? T(1e-6) : T(1e-14);
+}
+
+/**
+ * Noyau scalaire de référence.
+ */
+template <typename T>
+void tapKernelScalar(T* acc, const T* src, const T* coeffs, int points, size_t n)
+{
+    for (size_t i = 0; i < n; ++i) {
+        T sum = T(0);
+        for (int p = 0; p < points; ++p) {
+            sum += coeffs[p] * src[i + p];
+        }
+        acc[i] += sum;
+    }
+}
+
+/**
+ * Noyau scalaire de référence à gain variable.
+ */
+template <typename T>
+void modulatedTapKernelScalar(T* acc, const T* src, const T* coeffs, const T* gains, int points,
+                              size_t n)
+{
+    for (size_t i = 0; i < n; ++i) {
+        T sum = T(0);
+        for (int p = 0; p < points; ++p) {
+            sum += coeffs[p] * src[i + p];
+        }
+        acc[i] += gains[i] * sum;
+    }
+}
+
+/**
+ * Noyau scalaire de référence de la banque entrelacée.
+ */
+template <typename T>
+void bankKernelScalar(T* out, const T* history, const uint32_t* offsets, const T* c0,
+                      const T* c1, int num_taps, int lanes, uint32_t start, uint32_t mask,
+                      size_t n)
+{
+    const size_t num = static_cast<size_t>(num_taps) * static_cast<size_t>(lanes);
+    for (size_t i = 0; i < n; ++i) {
+        const uint32_t base = start + static_cast<uint32_t>(i * lanes);
+        T*             row  = out + i * lanes;
+        for (int l = 0; l < lanes; ++l) {
+            row[l] = T(0);
+        }
+        for (size_t at = 0; at < num; ++at) {
+            const uint32_t j0 = (base + offsets[at]) & mask;
+            const uint32_t j1 = (j0 + static_cast<uint32_t>(lanes)) & mask;
+            row[at % lanes] += c0[at] * history[j0] + c1[at] * history[j1];
+        }
+    }
+}
+
+#if MTSD_X86_SIMD
+
+MTSD_TARGET("sse2")
+inline void tapKernelSse2(double* acc, const double* src, const double* coeffs, int points,
+                          size_t n)
+{
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d sum = _mm_setzero_pd();
+        for (int p = 0; p < points; ++p) {
+            sum = _mm_add_pd(sum, _mm_mul_pd(_mm_set1_pd(coeffs[p]), _mm_loadu_pd(src + i + p)));
+        }
+        _mm_storeu_pd(acc + i, _mm_add_pd(_mm_loadu_pd(acc + i), sum));
+    }
+    tapKernelScalar(acc + i, src + i, coeffs, points, n - i);
+}
+
+MTSD_TARGET("sse2")
+inline void tapKernelSse2(float* acc, const float* src, const float* coeffs, int points, size_t n)
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 sum = _mm_setzero_ps();
+        for (int p = 0; p < points; ++p) {
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(coeffs[p]), _mm_loadu_ps(src + i + p)));
+        }
+        _mm_storeu_ps(acc + i, _mm_add_ps(_mm_loadu_ps(acc + i), sum));
+    }
+    tapKernelScalar(acc + i, src + i, coeffs, points, n - i);
+}
+
+MTSD_TARGET("avx2,fma")
+inline void tapKernelAvx2(double* acc, const double* src, const double* coeffs, int points,
+                          size_t n)
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d sum = _mm256_setzero_pd();
+        for (int p = 0; p < points; ++p) {
+            sum = _mm256_fmadd_pd(_mm256_set1_pd(coeffs[p]), _mm256_loadu_pd(src + i + p), sum);
+        }
+        _mm256_storeu_pd(acc + i, _mm256_add_pd(_mm256_loadu_pd(acc + i), sum));
+    }
+    tapKernelScalar(acc + i, src + i, coeffs, points, n - i);
+}
+
+MTSD_TARGET("avx2,fma")
+inline void tapKernelAvx2(float* acc, const float* src, const float* coeffs, int points, size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 sum = _mm256_setzero_ps();
+        for (int p = 0; p < points; ++p) {
+            sum = _mm256_fmadd_ps(_mm256_set1_ps(coeffs[p]), _mm256_loadu_ps(src + i + p), sum);
+        }
+        _mm256_storeu_ps(acc + i, _mm256_add_ps(_mm256_loadu_ps(acc + i), sum));
+    }
+    tapKernelScalar(acc + i, src + i, coeffs, points, n - i);
+}
+
+MTSD_TARGET("avx512f")
+inline void tapKernelAvx512(double* acc, const double* src, const double* coeffs, int points,
+                            size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512d sum = _mm512_setzero_pd();
+        for (int p = 0; p < points; ++p) {
+            sum = _mm512_fmadd_pd(_mm512_set1_pd(coeffs[p]), _mm512_loadu_pd(src + i + p), sum);
+        }
+        _mm512_storeu_pd(acc + i, _mm512_add_pd(_mm512_loadu_pd(acc + i), sum));
+    }
+    tapKernelScalar(acc + i, src + i, coeffs, points, n - i);
+}
+
+MTSD_TARGET("avx512f")
+inline void tapKernelAvx512(float* acc, const float* src, const float* coeffs, int points,
+                            size_t n)
+{
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512 sum = _mm512_setzero_ps();
+        for (int p = 0; p < points; ++p) {
+            sum = _mm512_fmadd_ps(_mm512_set1_ps(coeffs[p]), _mm512_loadu_ps(src + i + p), sum);
+        }
+        _mm512_storeu_ps(acc + i, _mm512_add_ps(_mm512_loadu_ps(acc + i), sum));
+    }
+    tapKernelScalar(acc + i, src + i, coeffs, points, n - i);
+}
+
+MTSD_TARGET("sse2")
+inline void modulatedTapKernelSse2(double* acc, const double* src, const double* coeffs,
+                                   const double* gains, int points, size_t n)
+{
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d sum = _mm_setzero_pd();
+        for (int p = 0; p < points; ++p) {
+            sum = _mm_add_pd(sum, _mm_mul_pd(_mm_set1_pd(coeffs[p]), _mm_loadu_pd(src + i + p)));
+        }
+        sum = _mm_mul_pd(_mm_loadu_pd(gains + i), sum);
+        _mm_storeu_pd(acc + i, _mm_add_pd(_mm_loadu_pd(acc + i), sum));
+    }
+    modulatedTapKernelScalar(acc + i, src + i, coeffs, gains + i, points, n - i);
+}
+
+MTSD_TARGET("sse2")
+inline void modulatedTapKernelSse2(float* acc, const float* src, const float* coeffs,
+                                   const float* gains, int points, size_t n)
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 sum = _mm_setzero_ps();
+        for (int p = 0; p < points; ++p) {
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(coeffs[p]), _mm_loadu_ps(src + i + p)));
+        }
+        sum = _mm_mul_ps(_mm_loadu_ps(gains + i), sum);
+        _mm_storeu_ps(acc + i, _mm_add_ps(_mm_loadu_ps(acc + i), sum));
+    }
+    modulatedTapKernelScalar(acc + i, src + i, coeffs, gains + i, points, n - i);
+}
+
+MTSD_TARGET("avx2,fma")
+inline void modulatedTapKernelAvx2(double* acc, const double* src, const double* coeffs,
+                                   const double* gains, int points, size_t n)
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d sum = _mm256_setzero_pd();
+        for (int p = 0; p < points; ++p) {
+            sum = _mm256_fmadd_pd(_mm256_set1_pd(coeffs[p]), _mm256_loadu_pd(src + i + p), sum);
+        }
+        sum = _mm256_fmadd_pd(_mm256_loadu_pd(gains + i), sum, _mm256_loadu_pd(acc + i));
+        _mm256_storeu_pd(acc + i, sum);
+    }
+    modulatedTapKernelScalar(acc + i, src + i, coeffs, gains + i, points, n - i);
+}
+
+MTSD_TARGET("avx2,fma")
+inline void modulatedTapKernelAvx2(float* acc, const float* src, const float* coeffs,
+                                   const float* gains, int points, size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 sum = _mm256_setzero_ps();
+        for (int p = 0; p < points; ++p) {
+            sum = _mm256_fmadd_ps(_mm256_set1_ps(coeffs[p]), _mm256_loadu_ps(src + i + p), sum);
+        }
+        sum = _mm256_fmadd_ps(_mm256_loadu_ps(gains + i), sum, _mm256_loadu_ps(acc + i));
+        _mm256_storeu_ps(acc + i, sum);
+    }
+    modulatedTapKernelScalar(acc + i, src + i, coeffs, gains + i, points, n - i);
+}
+
+MTSD_TARGET("avx512f")
+inline void modulatedTapKernelAvx512(double* acc, const double* src, const double* coeffs,
+                                     const double* gains, int points, size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512d sum = _mm512_setzero_pd();
+        for (int p = 0; p < points; ++p) {
+            sum = _mm512_fmadd_pd(_mm512_set1_pd(coeffs[p]), _mm512_loadu_pd(src + i + p), sum);
+        }
+        sum = _mm512_fmadd_pd(_mm512_loadu_pd(gains + i), sum, _mm512_loadu_pd(acc + i));
+        _mm512_storeu_pd(acc + i, sum);
+    }
+    modulatedTapKernelScalar(acc + i, src + i, coeffs, gains + i, points, n - i);
+}
+
+MTSD_TARGET("avx512f")
+inline void modulatedTapKernelAvx512(float* acc, const float* src, const float* coeffs,
+                                     const float* gains, int points, size_t n)
+{
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512 sum = _mm512_setzero_ps();
+        for (int p = 0; p < points; ++p) {
+            sum = _mm512_fmadd_ps(_mm512_set1_ps(coeffs[p]), _mm512_loadu_ps(src + i + p), sum);
+        }
+        sum = _mm512_fmadd_ps(_mm512_loadu_ps(gains + i), sum, _mm512_loadu_ps(acc + i));
+        _mm512_storeu_ps(acc + i, sum);
+    }
+    modulatedTapKernelScalar(acc + i, src + i, coeffs, gains + i, points, n - i);
+}
+
+MTSD_TARGET("avx2,fma")
+inline void bankKernelAvx2(double* out, const double* history, const uint32_t* offsets,
+                           const double* c0, const double* c1, int num_taps, int lanes,
+                           uint32_t start, uint32_t mask, size_t n)
+{
+    const __m128i vmask = _mm_set1_epi32(static_cast<int>(mask));
+    const __m128i step  = _mm_set1_epi32(lanes);
+    const __m256d zero  = _mm256_setzero_pd();  // Source des gathers masqués, tout actifs
+    const __m256d all   = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+    for (size_t i = 0; i < n; ++i) {
+        const __m128i base = _mm_set1_epi32(static_cast<int>(start + i * lanes));
+        for (int v = 0; v < lanes; v += 4) {
+            __m256d sum = _mm256_setzero_pd();
+            for (int k = 0; k < num_taps; ++k) {
+                const size_t at = static_cast<size_t>(k * lanes + v);
+
+                __m128i off = _mm_loadu_si128(reinterpret_cast<const __m128i*>(offsets + at));
+                __m128i j0  = _mm_and_si128(_mm_add_epi32(base, off), vmask);
+                __m128i j1  = _mm_and_si128(_mm_add_epi32(j0, step), vmask);
+                __m256d x0  = _mm256_mask_i32gather_pd(zero, history, j0, all, 8);
+                __m256d x1  = _mm256_mask_i32gather_pd(zero, history, j1, all, 8);
+                sum         = _mm256_fmadd_pd(_mm256_loadu_pd(c0 + at), x0, sum);
+                sum         = _mm256_fmadd_pd(_mm256_loadu_pd(c1 + at), x1, sum);
+            }
+            _mm256_storeu_pd(out + i * lanes + v, sum);
+        }
+    }
+}
+
+MTSD_TARGET("avx2,fma")
+inline void bankKernelAvx2(float* out, const float* history, const uint32_t* offsets,
+                           const float* c0, const float* c1, int num_taps, int lanes,
+                           uint32_t start, uint32_t mask, size_t n)
+{
+    const __m256i vmask = _mm256_set1_epi32(static_cast<int>(mask));
+    const __m256i step  = _mm256_set1_epi32(lanes);
+    for (size_t i = 0; i < n; ++i) {
+        const __m256i base = _mm256_set1_epi32(static_cast<int>(start + i * lanes));
+        for (int v = 0; v < lanes; v += 8) {
+            __m256 sum = _mm256_setzero_ps();
+            for (int k = 0; k < num_taps; ++k) {
+                const size_t at = static_cast<size_t>(k * lanes + v);
+
+                __m256i off = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(offsets + at));
+                __m256i j0  = _mm256_and_si256(_mm256_add_epi32(base, off), vmask);
+                __m256i j1  = _mm256_and_si256(_mm256_add_epi32(j0, step), vmask);
+                __m256  x0  = _mm256_i32gather_ps(history, j0, 4);
+                __m256  x1  = _mm256_i32gather_ps(history, j1, 4);
+                sum         = _mm256_fmadd_ps(_mm256_loadu_ps(c0 + at), x0, sum);
+                sum         = _mm256_fmadd_ps(_mm256_loadu_ps(c1 + at), x1, sum);
+            }
+            _mm256_storeu_ps(out + i * lanes + v, sum);
+        }
+    }
+}
+
+MTSD_TARGET("avx512f")
+inline void bankKernelAvx512(double* out, const double* history, const uint32_t* offsets,
+                             const double* c0, const double* c1, int num_taps, int lanes,
+                             uint32_t start, uint32_t mask, size_t n)
+{
+    const __m256i vmask = _mm256_set1_epi32(static_cast<int>(mask));
+    const __m256i step  = _mm256_set1_epi32(lanes);
+    const __m512d zero  = _mm512_setzero_pd();  // Source des gathers masqués, tout actifs
+    for (size_t i = 0; i < n; ++i) {
+        const __m256i base = _mm256_set1_epi32(static_cast<int>(start + i * lanes));
+        for (int v = 0; v < lanes; v += 8) {
+            __m512d sum = _mm512_setzero_pd();
+            for (int k = 0; k < num_taps; ++k) {
+                const size_t at = static_cast<size_t>(k * lanes + v);
+
+                __m256i off = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(offsets + at));
+                __m256i j0  = _mm256_and_si256(_mm256_add_epi32(base, off), vmask);
+                __m256i j1  = _mm256_and_si256(_mm256_add_epi32(j0, step), vmask);
+                __m512d x0  = _mm512_mask_i32gather_pd(zero, 0xFF, j0, history, 8);
+                __m512d x1  = _mm512_mask_i32gather_pd(zero, 0xFF, j1, history, 8);
+                sum         = _mm512_fmadd_pd(_mm512_loadu_pd(c0 + at), x0, sum);
+                sum         = _mm512_fmadd_pd(_mm512_loadu_pd(c1 + at), x1, sum);
+            }
+            _mm512_storeu_pd(out + i * lanes + v, sum);
+        }
+    }
+}
+
+MTSD_TARGET("avx512f")
+inline void bankKernelAvx512(float* out, const float* history, const uint32_t* offsets,
+                             const float* c0, const float* c1, int num_taps, int lanes,
+                             uint32_t start, uint32_t mask, size_t n)
+{
+    // 8 lignes en float : un vecteur AVX2 par échantillon
+    if (lanes != 16) {
+        bankKernelAvx2(out, history, offsets, c0, c1, num_taps, lanes, start, mask, n);
+        return;
+    }
+    const __m512i vmask = _mm512_set1_epi32(static_cast<int>(mask));
+    const __m512i step  = _mm512_set1_epi32(16);
+    const __m512  zero  = _mm512_setzero_ps();  // Source des gathers masqués, tout actifs
+    for (size_t i = 0; i < n; ++i) {
+        const __m512i base = _mm512_set1_epi32(static_cast<int>(start + i * 16));
+        __m512        sum  = _mm512_setzero_ps();
+        for (int k = 0; k < num_taps; ++k) {
+            const size_t at  = static_cast<size_t>(k) * 16;
+            __m512i      off = _mm512_loadu_si512(offsets + at);
+            __m512i      j0  = _mm512_and_si512(_mm512_add_epi32(base, off), vmask);
+            __m512i      j1  = _mm512_and_si512(_mm512_add_epi32(j0, step), vmask);
+            __m512       x0  = _mm512_mask_i32gather_ps(zero, 0xFFFF, j0, history, 4);
+            __m512       x1  = _mm512_mask_i32gather_ps(zero, 0xFFFF, j1, history, 4);
+            sum              = _mm512_fmadd_ps(_mm512_loadu_ps(c0 + at), x0, sum);
+            sum              = _mm512_fmadd_ps(_mm512_loadu_ps(c1 + at), x1, sum);
+        }
+        _mm512_storeu_ps(out + i * 16, sum);
+    }
+}
+
+#endif  // MTSD_X86_SIMD
+
+/**
+ * Indique si le CPU courant supporte un jeu d'instructions.
+ */
+inline bool simdSupported(SimdLevel level)
+{
+#if MTSD_X86_SIMD
+    switch (level) {
+        case SimdLevel::Scalar:
+            return true;
+        case SimdLevel::SSE2:
+            return __builtin_cpu_supports("sse2");
+        case SimdLevel::AVX2:
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        case SimdLevel::AVX512:
+            return __builtin_cpu_supports("avx512f");
+    }
+    return false;
+#else
+    return level == SimdLevel::Scalar;
+#endif
+}
+
+/**
+ * Retourne le jeu d'instructions le plus large supporté par le CPU courant
+ * (détecté une seule fois, par CPUID).
+ */
+inline SimdLevel detectSimdLevel()
+{
+    static const SimdLevel level = simdSupported(SimdLevel::AVX512) ? SimdLevel::AVX512
+                                   : simdSupported(SimdLevel::AVX2) ? SimdLevel::AVX2
+                                   : simdSupported(SimdLevel::SSE2) ? SimdLevel::SSE2
+                                                                    : SimdLevel::Scalar;
+    return level;
+}
+
+/**
+ * Retourne le noyau correspondant à un jeu d'instructions, ou le noyau scalaire
+ * si celui-ci n'est pas supporté par le CPU ou la plateforme.
+ */
+template <typename T>
+TapKernel<T> tapKernel(SimdLevel level = detectSimdLevel())
+{
+#if MTSD_X86_SIMD
+    if (simdSupported(level)) {
+        switch (level) {
+            case SimdLevel::Scalar:
+                break;
+            case SimdLevel::SSE2:
+                return static_cast<TapKernel<T>>(&tapKernelSse2);
+            case SimdLevel::AVX2:
+                return static_cast<TapKernel<T>>(&tapKernelAvx2);
+            case SimdLevel::AVX512:
+                return static_cast<TapKernel<T>>(&tapKernelAvx512);
+        }
+    }
+#else
+    (void)level;
+#endif
+    return &tapKernelScalar<T>;
+}
+
+/**
+ * Retourne le noyau à gain variable correspondant à un jeu d'instructions (voir tapKernel).
+ */
+template <typename T>
+ModulatedTapKernel<T> modulatedTapKernel(SimdLevel level = detectSimdLevel())
+{
+#if MTSD_X86_SIMD
+    if (simdSupported(level)) {
+        switch (level) {
+            case SimdLevel::Scalar:
+                break;
+            case SimdLevel::SSE2:
+                return static_cast<ModulatedTapKernel<T>>(&modulatedTapKernelSse2);
+            case SimdLevel::AVX2:
+                return static_cast<ModulatedTapKernel<T>>(&modulatedTapKernelAvx2);
+            case SimdLevel::AVX512:
+                return static_cast<ModulatedTapKernel<T>>(&modulatedTapKernelAvx512);
+        }
+    }
+#else
+    (void)level;
+#endif
+    return &modulatedTapKernelScalar<T>;
+}
+
+/**
+ * Retourne le noyau de banque entrelacée correspondant à un jeu d'instructions (voir
+ * tapKernel). SSE2 n'a pas de gather : le noyau scalaire est utilisé.
+ */
+template <typename T>
+BankKernel<T> bankKernel(SimdLevel level = detectSimdLevel())
+{
+#if MTSD_X86_SIMD
+    if (simdSupported(level)) {
+        switch (level) {
+            case SimdLevel::Scalar:
+            case SimdLevel::SSE2:
+                break;
+            case SimdLevel::AVX2:
+                return static_cast<BankKernel<T>>(&bankKernelAvx2);
+            case SimdLevel::AVX512:
+                return static_cast<BankKernel<T>>(&bankKernelAvx512);
+        }
+    }
+#else
+    (void)level;
+#endif
+    return &bankKernelScalar<T>;
+}
+
+/**
+ * Retourne le nom d'un jeu d'instructions (pour les rapports de mesure).
+ */
+inline const char* simdLevelName(SimdLevel level)
+{
+    switch (level) {
+        case SimdLevel::Scalar:
+            return "scalar";
+        case SimdLevel::SSE2:
+            return "sse2";
+        case SimdLevel::AVX2:
+            return "avx2";
+        case SimdLevel::AVX512:
+            return "avx512";
+    }
+    return "unknown";
+}
+
+#endif  // MULTI_TAP_SINC_DELAY_SIMD_H
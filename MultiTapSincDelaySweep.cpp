@@ -0,0 +1,498 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+#include "MultiTapSincDelay.h"
+
+// Balayage des performances de MultiTapSincDelay : K, taille maximale du buffer,
+// taille de bloc, précision des échantillons, disposition du buffer et mode des
+// paramètres (alpha statique ou en rampe, délai fixe, delta entier). Chaque
+// configuration est chauffée puis mesurée plusieurs fois sur un cœur épinglé ; la
+// médiane et l'écart absolu médian (MAD) du temps par échantillon et par tap sont
+// affichés, et écrits en CSV et/ou JSON (un résultat par ligne).
+// Avec --baseline, chaque configuration est comparée à une mesure de référence
+// (fichier JSON écrit par --json) et le programme échoue si l'une d'elles ralentit
+// de plus de --threshold pour cent (make perfcheck).
+//
+// Options (toutes facultatives, listes séparées par des virgules) :
+//   --k=0,1,...        valeurs de K (0 à 16 par défaut)
+//   --delays=4096,...  tailles maximales du buffer (4K, 64K, 1M et 16M par défaut)
+//   --blocks=64,...    tailles de bloc (64, 256 et 1024 par défaut)
+//   --types=float,double
+//   --layouts=pow2,mirrored
+//   --alphas=static,ramp,fixed,integer
+//                      alpha statique ou en rampe, délai fixe (tau1 == tau2, un seul
+//                      tap) ou delta entier (une interpolation pour tous les taps)
+//   --samples=N        échantillons par mesure (65536 par défaut)
+//   --warmup=N         mesures de chauffe non retenues (2 par défaut)
+//   --repeats=N        mesures retenues (9 par défaut)
+//   --cpu=N            cœur d'épinglage, -1 pour ne pas épingler (0 par défaut)
+//   --csv=fichier --json=fichier
+//   --quick            K=0,2,8, buffers 4K et 1M, blocs de 256
+//   --runs=N           balayages complets, le meilleur temps médian est retenu (1 par défaut)
+//   --baseline=fichier référence JSON à comparer
+//   --threshold=P      ralentissement toléré en pour cent (10 par défaut)
+
+/**
+ * Configuration du balayage, lue sur la ligne de commande.
+ */
+struct SweepOptions {
+    std::vector<int>         ks;
+    std::vector<size_t>      delays;
+    std::vector<size_t>      blocks;
+    std::vector<std::string> types;
+    std::vector<std::string> layouts;
+    std::vector<std::string> alphas;
+    size_t                   samples   = 65536;
+    int                      warmup    = 2;
+    int                      repeats   = 9;
+    int                      cpu       = 0;
+    int                      runs      = 1;
+    double                   threshold = 10.0;
+    std::string              csv;
+    std::string              json;
+    std::string              baseline;
+};
+
+/**
+ * Résultat d'une configuration. name identifie la configuration de façon unique
+ * (comparaison avec une mesure de référence).
+ */
+struct SweepResult {
+    std::string name;
+    std::string type;
+    std::string layout;
+    std::string alpha;
+    int         K;
+    size_t      max_delay;
+    size_t      block;
+    double      ns_per_sample_median;
+    double      ns_per_sample_mad;
+    double      ns_per_tap_median;
+    double      ns_per_tap_mad;
+    int         repeats;
+};
+
+/**
+ * Découpe une liste séparée par des virgules.
+ */
+std::vector<std::string> splitList(const std::string& list)
+{
+    std::vector<std::string> items;
+    size_t                   start = 0;
+    while (start <= list.size()) {
+        size_t end = list.find(',', start);
+        if (end == std::string::npos) {
+            end = list.size();
+        }
+        if (end > start) {
+            items.push_back(list.substr(start, end - start));
+        }
+        start = end + 1;
+    }
+    return items;
+}
+
+template <typename V>
+std::vector<V> parseNumbers(const std::string& list)
+{
+    std::vector<V> values;
+    for (const std::string& item : splitList(list)) {
+        values.push_back(static_cast<V>(std::strtoull(item.c_str(), nullptr, 10)));
+    }
+    return values;
+}
+
+/**
+ * Lit les options, les valeurs par défaut couvrant tout le balayage.
+ * @return false si la ligne de commande est invalide.
+ */
+bool parseOptions(int argc, char** argv, SweepOptions& options)
+{
+    for (int k = 0; k <= 16; ++k) {
+        options.ks.push_back(k);
+    }
+    options.delays  = {4096, 65536, 1 << 20, 1 << 24};
+    options.blocks  = {64, 256, 1024};
+    options.types   = {"float", "double"};
+    options.layouts = {"pow2", "mirrored"};
+    options.alphas  = {"static", "ramp", "fixed", "integer"};
+
+    for (int a = 1; a < argc; ++a) {
+        std::string arg   = argv[a];
+        size_t      equal = arg.find('=');
+        std::string key   = arg.substr(0, equal);
+        std::string value = (equal == std::string::npos) ? "" : arg.substr(equal + 1);
+        if (key == "--k") {
+            options.ks = parseNumbers<int>(value);
+        } else if (key == "--delays") {
+            options.delays = parseNumbers<size_t>(value);
+        } else if (key == "--blocks") {
+            options.blocks = parseNumbers<size_t>(value);
+        } else if (key == "--types") {
+            options.types = splitList(value);
+        } else if (key == "--layouts") {
+            options.layouts = splitList(value);
+        } else if (key == "--alphas") {
+            options.alphas = splitList(value);
+        } else if (key == "--samples") {
+            options.samples = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (key == "--warmup") {
+            options.warmup = std::atoi(value.c_str());
+        } else if (key == "--repeats") {
+            options.repeats = std::max(1, std::atoi(value.c_str()));
+        } else if (key == "--cpu") {
+            options.cpu = std::atoi(value.c_str());
+        } else if (key == "--csv") {
+            options.csv = value;
+        } else if (key == "--json") {
+            options.json = value;
+        } else if (key == "--runs") {
+            options.runs = std::max(1, std::atoi(value.c_str()));
+        } else if (key == "--baseline") {
+            options.baseline = value;
+        } else if (key == "--threshold") {
+            options.threshold = std::atof(value.c_str());
+        } else if (key == "--quick") {
+            options.ks     = {0, 2, 8};
+            options.delays = {4096, 1 << 20};
+            options.blocks = {256};
+        } else {
+            std::fprintf(stderr, "Unknown option %s (see the comment at the top of %s)\n",
+                         arg.c_str(), __FILE__);
+            return false;
+        }
+    }
+    if (options.blocks.empty() ||
+        std::count(options.blocks.begin(), options.blocks.end(), size_t(0)) > 0) {
+        std::fprintf(stderr, "Block sizes must be greater than 0.\n");
+        return false;
+    }
+    for (const std::string& type : options.types) {
+        if (type != "float" && type != "double") {
+            std::fprintf(stderr, "Unknown sample type %s (float or double)\n", type.c_str());
+            return false;
+        }
+    }
+    for (const std::string& layout : options.layouts) {
+        if (layout != "pow2" && layout != "mirrored") {
+            std::fprintf(stderr, "Unknown layout %s (pow2 or mirrored)\n", layout.c_str());
+            return false;
+        }
+    }
+    for (const std::string& alpha : options.alphas) {
+        if (alpha != "static" && alpha != "ramp" && alpha != "fixed" && alpha != "integer") {
+            std::fprintf(stderr, "Unknown alpha mode %s (static, ramp, fixed or integer)\n",
+                         alpha.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Épingle le thread courant sur un cœur (Linux uniquement).
+ */
+bool pinCurrentThread(int cpu)
+{
+#if defined(__linux__)
+    if (cpu < 0) {
+        return false;
+    }
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu, &cpus);
+    return sched_setaffinity(0, sizeof(cpus), &cpus) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+/**
+ * Médiane de values (modifié).
+ */
+double median(std::vector<double>& values)
+{
+    size_t middle = values.size() / 2;
+    std::nth_element(values.begin(), values.begin() + middle, values.end());
+    double upper = values[middle];
+    if (values.size() % 2 != 0) {
+        return upper;
+    }
+    double lower = *std::max_element(values.begin(), values.begin() + middle);
+    return 0.5 * (lower + upper);
+}
+
+/**
+ * Écart absolu médian de values autour de center.
+ */
+double medianAbsoluteDeviation(const std::vector<double>& values, double center)
+{
+    std::vector<double> deviations;
+    for (double value : values) {
+        deviations.push_back(std::abs(value - center));
+    }
+    return median(deviations);
+}
+
+/**
+ * Mesure une ligne pour chaque taille de bloc et chaque mode des paramètres. tau1 et
+ * tau2 sont au quart et à la moitié du buffer, pour que les taps auxiliaires s'étalent
+ * sur tout l'historique et que la taille du buffer pèse sur les caches. En délai fixe,
+ * tau2 = tau1 ; en delta entier, tau2 garde la partie fractionnaire de tau1.
+ */
+template <typename T>
+void sweepLine(const SweepOptions& options, const std::string& type, const std::string& layout,
+               size_t max_delay, int K, std::vector<SweepResult>& results)
+{
+    MultiTapSincDelay<T, double> line(max_delay, K, 44100.0,
+                                      layout == "pow2" ? BufferLayout::PowerOfTwo
+                                                       : BufferLayout::Mirrored);
+    const double tau1 = 0.25 * static_cast<double>(max_delay) + 0.3;
+    line.setTau1(tau1);
+
+    const size_t max_block = *std::max_element(options.blocks.begin(), options.blocks.end());
+    std::mt19937                      rng(1);
+    std::uniform_real_distribution<T> noise(T(-1), T(1));
+    std::vector<T>                    input(max_block);
+    std::vector<T>                    output(max_block);
+    for (T& sample : input) {
+        sample = noise(rng);
+    }
+    volatile T sink = T(0);  // Empêche l'élimination des sorties
+
+    for (size_t block : options.blocks) {
+        const size_t num_blocks = std::max<size_t>(1, options.samples / block);
+        for (const std::string& alpha : options.alphas) {
+            const bool ramp  = (alpha == "ramp");
+            const bool fixed = (alpha == "fixed");
+            if (fixed) {
+                line.setTau2(tau1);
+            } else if (alpha == "integer") {
+                line.setTau2(tau1 + 0.25 * static_cast<double>(max_delay));
+            } else {
+                line.setTau2(0.5 * static_cast<double>(max_delay) + 0.7);
+            }
+            line.setAlpha(0.37);
+
+            std::vector<double> ns_per_sample;
+            for (int run = -options.warmup; run < options.repeats; ++run) {
+                if (ramp) {
+                    // Rampe sur toute la mesure, dans un sens puis dans l'autre
+                    line.rampAlpha((run % 2 == 0) ? 1.0 : 0.0, num_blocks * block);
+                }
+                auto start = std::chrono::steady_clock::now();
+                for (size_t b = 0; b < num_blocks; ++b) {
+                    line.process(input.data(), output.data(), block);
+                }
+                auto stop = std::chrono::steady_clock::now();
+                sink      = sink + output[0];
+                if (run >= 0) {
+                    double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+                    ns_per_sample.push_back(ns / static_cast<double>(num_blocks * block));
+                }
+            }
+
+            SweepResult result;
+            result.type                 = type;
+            result.layout               = layout;
+            result.alpha                = alpha;
+            result.K                    = K;
+            result.max_delay            = max_delay;
+            result.block                = block;
+            result.repeats              = options.repeats;
+            result.ns_per_sample_median = median(ns_per_sample);
+            result.ns_per_sample_mad =
+                medianAbsoluteDeviation(ns_per_sample, result.ns_per_sample_median);
+            const double taps        = fixed ? 1.0 : static_cast<double>(2 * K + 2);
+            result.ns_per_tap_median = result.ns_per_sample_median / taps;
+            result.ns_per_tap_mad    = result.ns_per_sample_mad / taps;
+            result.name = type + "/" + layout + "/K=" + std::to_string(K) +
+                          "/delay=" + std::to_string(max_delay) + "/block=" +
+                          std::to_string(block) + "/" + alpha;
+            std::printf("%-52s : %8.2f ns/sample (MAD %6.2f)  %7.3f ns/tap\n",
+                        result.name.c_str(), result.ns_per_sample_median,
+                        result.ns_per_sample_mad, result.ns_per_tap_median);
+            std::fflush(stdout);
+            results.push_back(result);
+        }
+    }
+}
+
+bool writeCsv(const std::string& path, const std::vector<SweepResult>& results)
+{
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (file == nullptr) {
+        return false;
+    }
+    std::fprintf(file,
+                 "name,type,layout,K,max_delay,block,alpha,ns_per_sample_median,"
+                 "ns_per_sample_mad,ns_per_tap_median,ns_per_tap_mad,repeats\n");
+    for (const SweepResult& r : results) {
+        std::fprintf(file, "%s,%s,%s,%d,%zu,%zu,%s,%.4f,%.4f,%.5f,%.5f,%d\n", r.name.c_str(),
+                     r.type.c_str(), r.layout.c_str(), r.K, r.max_delay, r.block, r.alpha.c_str(),
+                     r.ns_per_sample_median, r.ns_per_sample_mad, r.ns_per_tap_median,
+                     r.ns_per_tap_mad, r.repeats);
+    }
+    std::fclose(file);
+    return true;
+}
+
+bool writeJson(const std::string& path, const std::vector<SweepResult>& results)
+{
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (file == nullptr) {
+        return false;
+    }
+    std::fprintf(file, "{\n  \"unit\": \"ns\",\n  \"simd\": \"%s\",\n  \"results\": [\n",
+                 simdLevelName(detectSimdLevel()));
+    for (size_t i = 0; i < results.size(); ++i) {
+        const SweepResult& r = results[i];
+        std::fprintf(file,
+                     "    {\"name\": \"%s\", \"type\": \"%s\", \"layout\": \"%s\", \"K\": %d, "
+                     "\"max_delay\": %zu, \"block\": %zu, \"alpha\": \"%s\", "
+                     "\"ns_per_sample_median\": %.4f, \"ns_per_sample_mad\": %.4f, "
+                     "\"ns_per_tap_median\": %.5f, \"ns_per_tap_mad\": %.5f, \"repeats\": %d}%s\n",
+                     r.name.c_str(), r.type.c_str(), r.layout.c_str(), r.K, r.max_delay, r.block,
+                     r.alpha.c_str(), r.ns_per_sample_median, r.ns_per_sample_mad,
+                     r.ns_per_tap_median, r.ns_per_tap_mad, r.repeats,
+                     (i + 1 < results.size()) ? "," : "");
+    }
+    std::fprintf(file, "  ]\n}\n");
+    std::fclose(file);
+    return true;
+}
+
+/**
+ * Lit les temps médians par échantillon d'un fichier écrit par writeJson(), un
+ * résultat par ligne (le format n'est pas un JSON quelconque).
+ * @return false si le fichier ne peut pas être lu.
+ */
+bool readBaseline(const std::string& path, std::map<std::string, double>& baseline)
+{
+    FILE* file = std::fopen(path.c_str(), "r");
+    if (file == nullptr) {
+        return false;
+    }
+    const char* name_key  = "\"name\": \"";
+    const char* value_key = "\"ns_per_sample_median\": ";
+    char        line[1024];
+    while (std::fgets(line, sizeof(line), file) != nullptr) {
+        const char* name  = std::strstr(line, name_key);
+        const char* value = std::strstr(line, value_key);
+        if (name == nullptr || value == nullptr) {
+            continue;
+        }
+        name += std::strlen(name_key);
+        const char* end = std::strchr(name, '"');
+        if (end != nullptr) {
+            baseline[std::string(name, end)] = std::atof(value + std::strlen(value_key));
+        }
+    }
+    std::fclose(file);
+    return true;
+}
+
+/**
+ * Compare chaque résultat à la référence. Une configuration absente de la référence
+ * est signalée sans faire échouer la comparaison.
+ * @return Le nombre de configurations ralenties de plus de threshold pour cent.
+ */
+size_t compareWithBaseline(const std::vector<SweepResult>&      results,
+                           const std::map<std::string, double>& baseline, double threshold)
+{
+    size_t regressions = 0;
+    size_t missing     = 0;
+    double worst       = 0.0;
+    for (const SweepResult& r : results) {
+        auto reference = baseline.find(r.name);
+        if (reference == baseline.end() || reference->second <= 0.0) {
+            ++missing;
+            continue;
+        }
+        double change = 100.0 * (r.ns_per_sample_median / reference->second - 1.0);
+        worst         = std::max(worst, change);
+        if (change > threshold) {
+            ++regressions;
+            std::printf("REGRESSION %-52s : %8.2f ns/sample, baseline %8.2f (%+.1f%%)\n",
+                        r.name.c_str(), r.ns_per_sample_median, reference->second, change);
+        }
+    }
+    std::printf("perfcheck: %zu of %zu configurations slower than baseline by more than %.1f%% "
+                "(worst %+.1f%%, %zu not in baseline)\n",
+                regressions, results.size() - missing, threshold, worst, missing);
+    return regressions;
+}
+
+int main(int argc, char** argv)
+{
+    SweepOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        return 2;
+    }
+    bool pinned = pinCurrentThread(options.cpu);
+    std::printf("SIMD level: %s, CPU %s, %d warmup + %d runs of %zu samples\n",
+                simdLevelName(detectSimdLevel()),
+                pinned ? std::to_string(options.cpu).c_str() : "not pinned", options.warmup,
+                options.repeats, options.samples);
+
+    std::map<std::string, double> baseline;
+    if (!options.baseline.empty() && !readBaseline(options.baseline, baseline)) {
+        std::fprintf(stderr, "Cannot read baseline %s\n", options.baseline.c_str());
+        return 1;
+    }
+
+    // Plusieurs balayages complets : une perturbation passagère ne touche qu'un passage
+    std::vector<SweepResult> results;
+    for (int run = 0; run < options.runs; ++run) {
+        std::vector<SweepResult> pass;
+        for (const std::string& type : options.types) {
+            for (const std::string& layout : options.layouts) {
+                for (size_t max_delay : options.delays) {
+                    for (int K : options.ks) {
+                        if (type == "float") {
+                            sweepLine<float>(options, type, layout, max_delay, K, pass);
+                        } else {
+                            sweepLine<double>(options, type, layout, max_delay, K, pass);
+                        }
+                    }
+                }
+            }
+        }
+        if (results.empty()) {
+            results = pass;
+            continue;
+        }
+        for (size_t i = 0; i < results.size(); ++i) {
+            if (pass[i].ns_per_sample_median < results[i].ns_per_sample_median) {
+                results[i] = pass[i];
+            }
+        }
+    }
+
+    if (!options.csv.empty() && !writeCsv(options.csv, results)) {
+        std::fprintf(stderr, "Cannot write %s\n", options.csv.c_str());
+        return 1;
+    }
+    if (!options.json.empty() && !writeJson(options.json, results)) {
+        std::fprintf(stderr, "Cannot write %s\n", options.json.c_str());
+        return 1;
+    }
+    if (!options.baseline.empty() &&
+        compareWithBaseline(results, baseline, options.threshold) > 0) {
+        return 1;
+    }
+    return 0;
+}
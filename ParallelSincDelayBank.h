@@ -0,0 +1,129 @@
+/************************************************************************
+ Banque de lignes MultiTapSincDelay traitée en parallèle par un
+ RealtimeThreadPool, avec un mixage de sortie déterministe.
+ ************************************************************************/
+
+#ifndef PARALLEL_SINC_DELAY_BANK_H
+#define PARALLEL_SINC_DELAY_BANK_H
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "MultiTapSincDelay.h"
+#include "RealtimeThreadPool.h"
+
+/**
+ * Banque de lignes à retard indépendantes, chacune avec sa propre entrée, réparties
+ * sur les threads d'un RealtimeThreadPool à chaque bloc.
+ *
+ * Les lignes sont regroupées en groupes consécutifs de kGroupSize lignes, qui sont
+ * les tâches du pool. Chaque groupe somme ses lignes dans l'ordre dans son propre bus,
+ * puis le thread appelant somme les bus dans l'ordre des groupes : l'ordre des
+ * additions flottantes ne dépend pas du nombre de threads, et le mixage est
+ * identique au bit près quel que soit le pool.
+ * @param T Le type des échantillons.
+ * @param P Le type des paramètres (voir MultiTapSincDelay).
+ */
+template <typename T = double, typename P = double>
+class ParallelSincDelayBank {
+   public:
+    static constexpr size_t kGroupSize = 8;
+
+    /**
+     * Constructeur. Toutes les mémoires de travail sont allouées ici.
+     * @param num_lines Le nombre de lignes.
+     * @param max_delay_samples Taille maximale du buffer de délai de chaque ligne.
+     * @param initial_K Valeur initiale du paramètre K de chaque ligne.
+     * @param max_block_size La taille maximale des blocs passés à process().
+     * @param layout Disposition mémoire des buffers (voir BufferLayout).
+     */
+    ParallelSincDelayBank(size_t num_lines, size_t max_delay_samples, int initial_K = 1,
+                          size_t max_block_size = 4096, P sample_rate = 44100.0,
+                          BufferLayout layout = BufferLayout::Mirrored)
+        : m_max_block_size(max_block_size),
+          m_num_groups((num_lines + kGroupSize - 1) / kGroupSize),
+          m_ins(nullptr),
+          m_outs(nullptr),
+          m_n(0)
+    {
+        if (num_lines == 0) {
+            MTSD_THROW(std::invalid_argument, "Number of lines must be greater than 0.");
+        }
+        m_lines.reserve(num_lines);
+        for (size_t l = 0; l < num_lines; ++l) {
+            m_lines.emplace_back(max_delay_samples, initial_K, sample_rate, layout);
+        }
+        m_buses.resize(m_num_groups * max_block_size);
+        m_scratch.resize(m_num_groups * max_block_size);
+    }
+
+    size_t numLines() const { return m_lines.size(); }
+
+    /**
+     * Retourne une ligne, pour régler ses paramètres entre deux blocs.
+     */
+    MultiTapSincDelay<T, P>&       line(size_t l) { return m_lines.at(l); }
+    const MultiTapSincDelay<T, P>& line(size_t l) const { return m_lines.at(l); }
+
+    /**
+     * Traite un bloc de toutes les lignes sur le pool.
+     * @param ins Les blocs d'entrée, un par ligne.
+     * @param outs Les blocs de sortie, un par ligne, ou nullptr si seul le mixage sert.
+     * @param mix Le bloc de sortie recevant la somme de toutes les lignes, ou nullptr.
+     * @param n Le nombre d'échantillons du bloc (au plus max_block_size).
+     */
+    void process(RealtimeThreadPool& pool, const T* const* ins, T* const* outs, T* mix, size_t n)
+    {
+        if (n > m_max_block_size) {
+            MTSD_THROW(std::invalid_argument, "Block size exceeds max_block_size.");
+        }
+        m_ins  = ins;
+        m_outs = outs;
+        m_n    = n;
+
+        auto task = [this](size_t group) { processGroup(group); };
+        pool.parallelFor(m_num_groups, task);
+
+        if (mix != nullptr) {
+            std::fill(mix, mix + n, T(0));
+            for (size_t g = 0; g < m_num_groups; ++g) {
+                const T* bus = &m_buses[g * m_max_block_size];
+                for (size_t i = 0; i < n; ++i) {
+                    mix[i] += bus[i];
+                }
+            }
+        }
+    }
+
+   private:
+    void processGroup(size_t group)
+    {
+        T*           bus   = &m_buses[group * m_max_block_size];
+        const size_t begin = group * kGroupSize;
+        const size_t end   = std::min(begin + kGroupSize, m_lines.size());
+
+        std::fill(bus, bus + m_n, T(0));
+        for (size_t l = begin; l < end; ++l) {
+            T* out = (m_outs != nullptr) ? m_outs[l] : &m_scratch[group * m_max_block_size];
+            m_lines[l].process(m_ins[l], out, m_n);
+            for (size_t i = 0; i < m_n; ++i) {
+                bus[i] += out[i];
+            }
+        }
+    }
+
+    size_t                               m_max_block_size;
+    size_t                               m_num_groups;
+    std::vector<MultiTapSincDelay<T, P>> m_lines;
+    std::vector<T>                       m_buses;    // Un bus de mixage par groupe
+    std::vector<T>                       m_scratch;  // Sorties des lignes sans outs
+
+    // Arguments du bloc courant, lus par les tâches
+    const T* const* m_ins;
+    T* const*       m_outs;
+    size_t          m_n;
+};
+
+#endif  // PARALLEL_SINC_DELAY_BANK_H
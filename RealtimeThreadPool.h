@@ -0,0 +1,241 @@
+/************************************************************************
+ Pool de threads fork/join pour le callback audio : travailleurs épinglés,
+ attente active puis futex, sans mutex ni variable de condition.
+ ************************************************************************/
+
+#ifndef REALTIME_THREAD_POOL_H
+#define REALTIME_THREAD_POOL_H
+
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Pause d'une itération d'attente active (instruction PAUSE sur x86).
+ */
+inline void cpuRelax()
+{
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+    __builtin_ia32_pause();
+#endif
+}
+
+/**
+ * Endort le thread tant que word vaut expected (futex sous Linux, yield ailleurs).
+ */
+inline void futexWait(std::atomic<uint32_t>& word, uint32_t expected)
+{
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr,
+            nullptr, 0);
+#else
+    if (word.load() == expected) {
+        std::this_thread::yield();
+    }
+#endif
+}
+
+/**
+ * Réveille tous les threads endormis sur word.
+ */
+inline void futexWakeAll(std::atomic<uint32_t>& word)
+{
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr,
+            nullptr, 0);
+#else
+    (void)word;
+#endif
+}
+
+/**
+ * Pool fork/join à découpage statique : parallelFor(num_tasks, fn) répartit les tâches
+ * 0..num_tasks-1 en plages contiguës, une par thread, le thread appelant (le callback
+ * audio) prenant la première. Le découpage ne dépend que de num_tasks et du nombre de
+ * threads : d'un bloc à l'autre, une tâche s'exécute sur le même cœur et ses données
+ * restent dans son cache.
+ *
+ * Les travailleurs attendent le bloc suivant par attente active pendant spin_count
+ * itérations, puis s'endorment sur un futex ; le thread appelant attend la fin des
+ * travailleurs de la même façon. Aucun mutex n'est pris et rien n'est alloué par
+ * parallelFor(). Les tâches ne doivent pas lever d'exception.
+ */
+class RealtimeThreadPool {
+   public:
+    static constexpr uint32_t kDefaultSpinCount = 1 << 14;
+
+    /**
+     * Constructeur.
+     * @param num_threads Le nombre total de threads, thread appelant compris (au moins 1).
+     * @param pin_threads true pour épingler le travailleur i au cœur i (Linux uniquement).
+     * @param spin_count Le nombre d'itérations d'attente active avant de s'endormir.
+     */
+    explicit RealtimeThreadPool(size_t num_threads, bool pin_threads = true,
+                                uint32_t spin_count = kDefaultSpinCount)
+        : m_num_threads(num_threads > 0 ? num_threads : 1),
+          m_spin_count(spin_count),
+          m_generation(0),
+          m_pending(0),
+          m_sleepers(0),
+          m_joinWaiting(0),
+          m_stop(false),
+          m_task(nullptr),
+          m_context(nullptr),
+          m_num_tasks(0)
+    {
+        const size_t num_cpus = std::thread::hardware_concurrency();
+        for (size_t i = 1; i < m_num_threads; ++i) {
+            m_workers.emplace_back(&RealtimeThreadPool::workerLoop, this, i);
+#if defined(__linux__)
+            if (pin_threads && num_cpus > 0) {
+                cpu_set_t cpus;
+                CPU_ZERO(&cpus);
+                CPU_SET(static_cast<int>(i % num_cpus), &cpus);
+                pthread_setaffinity_np(m_workers.back().native_handle(), sizeof(cpus), &cpus);
+            }
+#else
+            (void)pin_threads;
+            (void)num_cpus;
+#endif
+        }
+    }
+
+    ~RealtimeThreadPool()
+    {
+        m_stop.store(true);
+        m_generation.fetch_add(1);
+        futexWakeAll(m_generation);
+        for (std::thread& worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    RealtimeThreadPool(const RealtimeThreadPool&)            = delete;
+    RealtimeThreadPool& operator=(const RealtimeThreadPool&) = delete;
+
+    /**
+     * Retourne le nombre total de threads, thread appelant compris.
+     */
+    size_t numThreads() const { return m_num_threads; }
+
+    /**
+     * Retourne la plage [begin, end) des tâches exécutées par un thread.
+     */
+    static void partition(size_t num_tasks, size_t num_threads, size_t thread, size_t& begin,
+                          size_t& end)
+    {
+        begin = num_tasks * thread / num_threads;
+        end   = num_tasks * (thread + 1) / num_threads;
+    }
+
+    /**
+     * Exécute fn(task) pour chaque task de 0 à num_tasks-1 et attend la fin de toutes
+     * les tâches. À appeler depuis un seul thread (le callback audio).
+     */
+    template <typename F>
+    void parallelFor(size_t num_tasks, F& fn)
+    {
+        m_task      = [](void* context, size_t task) { (*static_cast<F*>(context))(task); };
+        m_context   = &fn;
+        m_num_tasks = num_tasks;
+
+        if (m_workers.empty()) {
+            runRange(0);
+            return;
+        }
+
+        // Fork : les travailleurs voient la tâche après l'incrément de génération
+        m_pending.store(static_cast<uint32_t>(m_workers.size()));
+        m_generation.fetch_add(1);
+        if (m_sleepers.load() > 0) {
+            futexWakeAll(m_generation);
+        }
+
+        runRange(0);
+
+        // Join : attente active, puis futex sur le compteur de travailleurs restants
+        uint32_t spins = 0;
+        for (uint32_t pending = m_pending.load(); pending != 0; pending = m_pending.load()) {
+            if (spins < m_spin_count) {
+                ++spins;
+                cpuRelax();
+                continue;
+            }
+            m_joinWaiting.store(1);
+            if (m_pending.load() == pending) {
+                futexWait(m_pending, pending);
+            }
+            m_joinWaiting.store(0);
+        }
+    }
+
+   private:
+    void runRange(size_t thread)
+    {
+        size_t begin = 0;
+        size_t end   = 0;
+        partition(m_num_tasks, m_num_threads, thread, begin, end);
+        for (size_t task = begin; task < end; ++task) {
+            m_task(m_context, task);
+        }
+    }
+
+    void workerLoop(size_t thread)
+    {
+        // Génération initiale : un fork peut précéder le démarrage du travailleur
+        uint32_t seen = 0;
+        for (;;) {
+            // Attente du fork suivant : attente active, puis futex
+            uint32_t spins = 0;
+            while (m_generation.load() == seen) {
+                if (spins < m_spin_count) {
+                    ++spins;
+                    cpuRelax();
+                    continue;
+                }
+                m_sleepers.fetch_add(1);
+                futexWait(m_generation, seen);
+                m_sleepers.fetch_sub(1);
+            }
+            seen = m_generation.load();
+            if (m_stop.load()) {
+                return;
+            }
+
+            runRange(thread);
+
+            if (m_pending.fetch_sub(1) == 1 && m_joinWaiting.load() != 0) {
+                futexWakeAll(m_pending);
+            }
+        }
+    }
+
+    size_t                   m_num_threads;
+    uint32_t                 m_spin_count;
+    std::vector<std::thread> m_workers;
+
+    // Opérations atomiques séquentiellement cohérentes : un thread qui s'endort
+    // (m_sleepers, m_joinWaiting) ne peut pas manquer le réveil correspondant
+    std::atomic<uint32_t> m_generation;   // Incrémenté à chaque fork
+    std::atomic<uint32_t> m_pending;      // Travailleurs n'ayant pas fini le fork courant
+    std::atomic<uint32_t> m_sleepers;     // Travailleurs endormis sur m_generation
+    std::atomic<uint32_t> m_joinWaiting;  // Thread appelant endormi sur m_pending
+    std::atomic<bool>     m_stop;
+
+    void (*m_task)(void*, size_t);
+    void*  m_context;
+    size_t m_num_tasks;
+};
+
+#endif  // REALTIME_THREAD_POOL_H
@@ -0,0 +1,200 @@
+/************************************************************************
+ Mises à jour des paramètres de MultiTapSincDelay depuis un thread de
+ contrôle (interface, réseau), sans verrou côté audio.
+ ************************************************************************/
+
+#ifndef SINC_DELAY_CONTROL_H
+#define SINC_DELAY_CONTROL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include "MultiTapSincDelay.h"
+
+/**
+ * Jeu complet de paramètres d'une ligne, publié en une fois pour que le thread audio
+ * ne voie jamais un couple (tau1, tau2) déchiré.
+ */
+template <typename P = double>
+struct SincDelayParams {
+    P   tau1;
+    P   tau2;
+    P   alpha;
+    int K;
+};
+
+/**
+ * Boîte aux lettres à un écrivain et un lecteur (triple buffer), sans attente des
+ * deux côtés. L'écrivain remplit sa case puis l'échange avec la case du milieu ; le
+ * lecteur échange sa case avec celle du milieu seulement si elle est nouvelle. Les
+ * valeurs intermédiaires non lues sont écrasées (coalescence) et le lecteur obtient
+ * toujours la dernière valeur complète.
+ * @param V Le type de valeur, copiable trivialement.
+ */
+template <typename V>
+class ParameterMailbox {
+   public:
+    ParameterMailbox() : m_back(0), m_front(1), m_middle(2) {}
+
+    explicit ParameterMailbox(const V& initial) : ParameterMailbox()
+    {
+        for (Slot& slot : m_slots) {
+            slot.value = initial;
+        }
+    }
+
+    /**
+     * Publie une valeur (thread de contrôle uniquement).
+     */
+    void write(const V& value)
+    {
+        m_slots[m_back].value = value;
+        uint8_t previous      = m_middle.exchange(m_back | kFresh, std::memory_order_acq_rel);
+        m_back                = previous & kIndexMask;
+    }
+
+    /**
+     * Récupère la dernière valeur publiée si elle n'a pas encore été lue (thread audio
+     * uniquement).
+     * @return true si value a été mise à jour.
+     */
+    bool read(V& value)
+    {
+        if ((m_middle.load(std::memory_order_relaxed) & kFresh) == 0) {
+            return false;
+        }
+        uint8_t previous = m_middle.exchange(m_front, std::memory_order_acq_rel);
+        m_front          = previous & kIndexMask;
+        value            = m_slots[m_front].value;
+        return true;
+    }
+
+   private:
+    static constexpr uint8_t kIndexMask = 3;
+    static constexpr uint8_t kFresh     = 4;  // Case du milieu publiée et non lue
+
+    // Une ligne de cache par case : l'écrivain et le lecteur ne se partagent que m_middle
+    struct alignas(64) Slot {
+        V value;
+    };
+
+    Slot                 m_slots[3];
+    uint8_t              m_back;    // Case de l'écrivain
+    uint8_t              m_front;   // Case du lecteur
+    std::atomic<uint8_t> m_middle;  // Case échangée, avec le drapeau kFresh
+};
+
+/**
+ * MultiTapSincDelay piloté par un thread de contrôle. publish() valide les paramètres
+ * et lève une exception sur le thread de contrôle ; process() prend le dernier jeu
+ * publié au début de chaque appel (au bloc, ou à l'échantillon avec process(T)),
+ * sans verrou, sans allocation et sans exception côté audio.
+ *
+ * Les vecteurs de taps sont dimensionnés pour max_K à la construction, un changement
+ * de K n'alloue donc rien. Les gains sont calculés exactement : la table de gains
+ * partagée (SincGainTable::get) prend un mutex et n'est pas utilisée ici.
+ * @param T Le type des échantillons.
+ * @param P Le type des paramètres.
+ */
+template <typename T = double, typename P = double>
+class ControlledSincDelay {
+   public:
+    /**
+     * Constructeur.
+     * @param max_delay_samples Taille maximale du buffer de délai en échantillons.
+     * @param initial_K Valeur initiale du paramètre K.
+     * @param max_K La plus grande valeur de K qui pourra être publiée.
+     * @param layout Disposition mémoire du buffer (voir BufferLayout).
+     */
+    ControlledSincDelay(size_t max_delay_samples, int initial_K = 1, int max_K = 16,
+                        P sample_rate = 44100.0, BufferLayout layout = BufferLayout::Mirrored)
+        : m_max_delay_samples(max_delay_samples),
+          m_max_K(max_K),
+          m_line(max_delay_samples, initial_K, sample_rate, layout),
+          m_current{P(1), P(2), P(0), initial_K},
+          m_mailbox(m_current)
+    {
+        if (initial_K < 0 || initial_K > max_K) {
+            MTSD_THROW(std::invalid_argument, "K must be between 0 and max_K.");
+        }
+        m_line.reserveK(max_K);  // trySetK() reste ensuite dans la capacité réservée
+    }
+
+    /**
+     * Publie un jeu de paramètres (thread de contrôle uniquement). Les publications
+     * successives non encore prises par le thread audio sont fusionnées : seule la
+     * dernière est appliquée.
+     */
+    void publish(const SincDelayParams<P>& params)
+    {
+        const P limit = static_cast<P>(m_max_delay_samples) - P(1);
+        if (params.tau1 < P(0) || params.tau1 >= limit) {
+            MTSD_THROW(std::out_of_range, "Tau1 must be between 0.0 and max_delay_samples - 1.0");
+        }
+        if (params.tau2 < P(0) || params.tau2 >= limit) {
+            MTSD_THROW(std::out_of_range, "Tau2 must be between 0.0 and max_delay_samples - 1.0");
+        }
+        if (params.alpha < P(0) || params.alpha > P(1)) {
+            MTSD_THROW(std::invalid_argument, "Alpha must be between 0.0 and 1.0.");
+        }
+        if (params.K < 0 || params.K > m_max_K) {
+            MTSD_THROW(std::invalid_argument, "K must be between 0 and max_K.");
+        }
+        m_mailbox.write(params);
+    }
+
+    /**
+     * Traite un échantillon avec les derniers paramètres publiés (thread audio).
+     */
+    T process(T inputSample) noexcept
+    {
+        applyPending();
+        return m_line.process(inputSample);
+    }
+
+    /**
+     * Traite un bloc avec les derniers paramètres publiés (thread audio).
+     */
+    void process(const T* in, T* out, size_t n) noexcept
+    {
+        applyPending();
+        m_line.process(in, out, n);
+    }
+
+    /**
+     * Retourne les paramètres appliqués par le dernier process() (thread audio).
+     */
+    const SincDelayParams<P>& current() const { return m_current; }
+
+    /**
+     * Retourne la ligne pilotée, pour les réglages hors paramètres (thread audio).
+     */
+    MultiTapSincDelay<T, P>& line() { return m_line; }
+
+   private:
+    /**
+     * Applique le dernier jeu publié, s'il y en a un. Les valeurs ont été validées par
+     * publish() : les setters sans exception renvoient Ok, et trySetK reste dans la
+     * capacité réservée.
+     */
+    void applyPending() noexcept
+    {
+        if (!m_mailbox.read(m_current)) {
+            return;
+        }
+        m_line.trySetK(m_current.K);
+        m_line.trySetTau1(m_current.tau1);
+        m_line.trySetTau2(m_current.tau2);
+        m_line.trySetAlpha(m_current.alpha);
+    }
+
+    size_t                               m_max_delay_samples;
+    int                                  m_max_K;
+    MultiTapSincDelay<T, P>              m_line;
+    SincDelayParams<P>                   m_current;  // Paramètres appliqués (thread audio)
+    ParameterMailbox<SincDelayParams<P>> m_mailbox;
+};
+
+#endif  // SINC_DELAY_CONTROL_H
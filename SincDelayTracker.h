@@ -0,0 +1,216 @@
+/************************************************************************
+ Suivi de délais cibles : les transitions tau1 -> tau2 de MultiTapSincDelay
+ sont planifiées automatiquement à partir d'un flux de délais cibles
+ (suivi de tête, positions de sources).
+ ************************************************************************/
+
+#ifndef SINC_DELAY_TRACKER_H
+#define SINC_DELAY_TRACKER_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+
+#include "MultiTapSincDelay.h"
+
+/**
+ * Traitement des cibles qui arrivent pendant une transition.
+ */
+enum class TargetPolicy {
+    Merge,  // Seule la dernière cible reçue est gardée pour la transition suivante
+    Queue   // Les cibles sont enchaînées dans l'ordre d'arrivée (kMaxQueuedTargets au plus)
+};
+
+/**
+ * Ligne à retard pilotée par des délais cibles. Chaque nouvelle cible démarre une
+ * transition : tau2 reçoit la cible et alpha monte de 0 à 1 en transition_samples
+ * échantillons (rampe intégrée par process(), voir MultiTapSincDelay::rampAlpha).
+ * Quand alpha atteint 1, tau1 <- tau2 et alpha <- 0, ce qui ne change pas la sortie,
+ * et la cible suivante éventuelle démarre au même échantillon.
+ *
+ * Les cibles sont validées une fois par setTarget() ; les blocs sont découpés aux fins
+ * de transition, sans appel de setter par échantillon. process() n'utilise que les
+ * setters sans exception (trySetTau1, ...).
+ * @param T Le type des échantillons.
+ * @param P Le type des paramètres.
+ */
+template <typename T = double, typename P = double>
+class SincDelayTracker {
+   public:
+    static constexpr size_t kMaxQueuedTargets = 16;
+
+    /**
+     * Constructeur.
+     * @param max_delay_samples Taille maximale du buffer de délai en échantillons.
+     * @param initial_delay Le délai initial (en échantillons).
+     * @param transition_samples La durée d'une transition en échantillons (au moins 1).
+     * @param initial_K Valeur initiale du paramètre K.
+     * @param policy Le traitement des cibles reçues pendant une transition.
+     * @param layout Disposition mémoire du buffer (voir BufferLayout).
+     */
+    SincDelayTracker(size_t max_delay_samples, P initial_delay, size_t transition_samples,
+                     int initial_K = 1, TargetPolicy policy = TargetPolicy::Merge,
+                     P sample_rate = 44100.0, BufferLayout layout = BufferLayout::Mirrored)
+        : m_line(max_delay_samples, initial_K, sample_rate, layout),
+          m_max_delay_samples(max_delay_samples),
+          m_policy(policy),
+          m_transition_samples(0),
+          m_remaining(0),
+          m_tau1(initial_delay),
+          m_tau2(initial_delay),
+          m_queueHead(0),
+          m_queueCount(0),
+          m_completed(0)
+    {
+        setTransitionSamples(transition_samples);
+        m_line.setTau1(initial_delay);
+        m_line.setTau2(initial_delay);
+        m_line.setAlpha(P(0));
+    }
+
+    /**
+     * Définit la durée des transitions suivantes (en échantillons, au moins 1).
+     */
+    void setTransitionSamples(size_t transition_samples)
+    {
+        if (transition_samples == 0) {
+            MTSD_THROW(std::invalid_argument, "Transition samples must be greater than 0.");
+        }
+        m_transition_samples = transition_samples;
+    }
+
+    /**
+     * Reçoit un nouveau délai cible (en échantillons). Sans transition en cours, elle
+     * démarre au prochain échantillon traité ; sinon la cible est fusionnée ou mise
+     * en file selon la politique. File pleine : la dernière cible en file est remplacée.
+     */
+    void setTarget(P delay)
+    {
+        if (delay < P(0) || delay >= static_cast<P>(m_max_delay_samples) - P(1)) {
+            MTSD_THROW(std::out_of_range,
+                       "Target delay must be between 0.0 and max_delay_samples - 1.0");
+        }
+        if (m_queueCount > 0 && (m_policy == TargetPolicy::Merge ||
+                                 m_queueCount == kMaxQueuedTargets)) {
+            m_queue[(m_queueHead + m_queueCount - 1) % kMaxQueuedTargets] = delay;
+            return;
+        }
+        m_queue[(m_queueHead + m_queueCount) % kMaxQueuedTargets] = delay;
+        ++m_queueCount;
+    }
+
+    /**
+     * Traite un échantillon audio.
+     */
+    T process(T inputSample) noexcept
+    {
+        T output = T(0);
+        process(&inputSample, &output, 1);
+        return output;
+    }
+
+    /**
+     * Traite un bloc, découpé aux fins de transition pour que la cible suivante
+     * démarre à l'échantillon exact.
+     */
+    void process(const T* in, T* out, size_t n) noexcept
+    {
+        for (size_t start = 0; start < n;) {
+            if (m_remaining == 0) {
+                startNextTransition();
+            }
+            size_t count = (m_remaining > 0) ? std::min(m_remaining, n - start) : n - start;
+            m_line.process(in + start, out + start, count);
+            start += count;
+
+            if (m_remaining > 0) {
+                m_remaining -= count;
+                if (m_remaining == 0) {
+                    finishTransition();
+                }
+            }
+        }
+    }
+
+    /**
+     * Retourne le délai effectif courant (1 - alpha) * tau1 + alpha * tau2.
+     */
+    P currentDelay() const
+    {
+        P alpha = m_line.getAlpha();
+        return (P(1) - alpha) * m_tau1 + alpha * m_tau2;
+    }
+
+    /**
+     * Retourne le délai visé par la transition en cours, ou le délai courant.
+     */
+    P targetDelay() const { return m_tau2; }
+
+    bool   isTransitioning() const { return m_remaining > 0; }
+    size_t pendingTargets() const { return m_queueCount; }
+
+    /**
+     * Retourne le nombre de transitions terminées depuis la construction.
+     */
+    size_t completedTransitions() const { return m_completed; }
+
+    /**
+     * Retourne la ligne pilotée (K, table de gains, jeu d'instructions).
+     */
+    MultiTapSincDelay<T, P>& line() { return m_line; }
+
+   private:
+    /**
+     * Démarre la transition vers la prochaine cible en file qui diffère du délai
+     * courant (les cibles égales sont ignorées).
+     */
+    void startNextTransition() noexcept
+    {
+        const P epsilon = std::numeric_limits<P>::epsilon() * 100;
+        while (m_queueCount > 0) {
+            P target    = m_queue[m_queueHead];
+            m_queueHead = (m_queueHead + 1) % kMaxQueuedTargets;
+            --m_queueCount;
+            if (std::abs(target - m_tau1) < epsilon) {
+                continue;
+            }
+            // alpha = 0 : la sortie reste au délai tau1 au premier échantillon
+            m_tau2 = target;
+            m_line.trySetTau2(target);
+            m_line.trySetAlpha(P(0));
+            m_line.tryRampAlpha(P(1), m_transition_samples);
+            m_remaining = m_transition_samples;
+            return;
+        }
+    }
+
+    /**
+     * Fin de transition (alpha = 1) : tau1 <- tau2, alpha <- 0.
+     */
+    void finishTransition() noexcept
+    {
+        m_tau1 = m_tau2;
+        m_line.trySetTau1(m_tau1);
+        m_line.trySetAlpha(P(0));
+        ++m_completed;
+    }
+
+    MultiTapSincDelay<T, P> m_line;
+    size_t                  m_max_delay_samples;
+    TargetPolicy            m_policy;
+    size_t                  m_transition_samples;
+    size_t                  m_remaining;  // Échantillons restants de la transition en cours
+    P                       m_tau1;       // Copies de tau1 et tau2 de la ligne
+    P                       m_tau2;
+
+    // File circulaire des cibles en attente (sans allocation)
+    std::array<P, kMaxQueuedTargets> m_queue;
+    size_t                           m_queueHead;
+    size_t                           m_queueCount;
+    size_t                           m_completed;
+};
+
+#endif  // SINC_DELAY_TRACKER_H
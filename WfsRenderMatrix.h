@@ -0,0 +1,269 @@
+/************************************************************************
+ Matrice de rendu WFS : N sources x M haut-parleurs, chaque couple
+ (source, haut-parleur) étant une lecture multi-tap sinc avec gain,
+ sommée dans le bus du haut-parleur.
+ ************************************************************************/
+
+#ifndef WFS_RENDER_MATRIX_H
+#define WFS_RENDER_MATRIX_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "MultiTapSincDelay.h"
+
+/**
+ * Moteur de rendu N sources x M haut-parleurs. Chaque source a un seul historique
+ * (SincDelayBuffer, disposition Mirrored), lu par M routes : une route (source,
+ * haut-parleur) a ses propres tau1, tau2, alpha et gain, K étant commun à la matrice.
+ * Les paramètres des routes sont stockés en structure de tableaux (SoA), indexés par
+ * source * M + haut-parleur. Le traitement est bloqué par source : pour chaque
+ * sous-bloc, l'historique d'une source est écrit puis lu par toutes ses routes tant
+ * qu'il est en cache, chaque route s'accumulant directement dans son bus de sortie.
+ * @param T Le type des échantillons.
+ * @param P Le type des paramètres (voir MultiTapSincDelay).
+ */
+template <typename T = double, typename P = double>
+class WfsRenderMatrix {
+   public:
+    static constexpr size_t kMaxBlockSize = SincDelayBuffer<T>::kMaxBlockSize;
+
+    /**
+     * Constructeur. Toutes les routes sont initialisées à tau1 = tau2 = 1, alpha = 0
+     * et gain = 0 (route muette).
+     * @param max_delay_samples Délai maximal (en échantillons), commun à toutes les routes.
+     * @param num_sources Le nombre de sources N.
+     * @param num_speakers Le nombre de haut-parleurs M.
+     * @param initial_K Valeur initiale du paramètre K, commun à toutes les routes.
+     */
+    WfsRenderMatrix(size_t max_delay_samples, size_t num_sources, size_t num_speakers,
+                    int initial_K = 1, P sample_rate = 44100.0)
+        : m_max_delay_samples(max_delay_samples),
+          m_num_sources(num_sources),
+          m_num_speakers(num_speakers),
+          m_K(0),
+          m_sampleRate(sample_rate)
+    {
+        if (num_sources == 0 || num_speakers == 0) {
+            MTSD_THROW(std::invalid_argument,
+                       "Number of sources and speakers must be greater than 0.");
+        }
+        m_buffers.reserve(num_sources);
+        for (size_t s = 0; s < num_sources; ++s) {
+            m_buffers.emplace_back(max_delay_samples, BufferLayout::Mirrored);
+        }
+        const size_t num_routes = num_sources * num_speakers;
+        m_tau1.assign(num_routes, P(1));
+        m_tau2.assign(num_routes, P(1));
+        m_alpha.assign(num_routes, P(0));
+        m_gain.assign(num_routes, T(0));
+        m_fixed.resize(num_routes);
+        m_bus.resize(num_speakers * kMaxBlockSize);
+        setK(initial_K);
+    }
+
+    /**
+     * Définit le paramètre K (nombre de paires de taps auxiliaires) de toutes les routes.
+     */
+    void setK(int newK)
+    {
+        if (newK < 0) {
+            MTSD_THROW(std::invalid_argument, "K cannot be negative.");
+        }
+        m_K = newK;
+        m_tapDelays.resize(m_tau1.size() * static_cast<size_t>(numTaps()));
+        m_tapGains.resize(m_tau1.size() * static_cast<size_t>(numTaps()));
+        if (m_gainTable) {
+            m_gainTable = SincGainTable::get(m_K, m_gainTable->resolution());
+        }
+    }
+
+    /**
+     * Active la lecture des gains hk dans une table précalculée partagée
+     * (voir SincGainTable), 0 pour revenir au calcul exact.
+     */
+    void useGainTable(size_t resolution = SincGainTable::kDefaultResolution)
+    {
+        m_gainTable = (resolution > 0) ? SincGainTable::get(m_K, resolution) : nullptr;
+    }
+
+    int getK() const { return m_K; }
+    int numTaps() const { return 2 * m_K + 2; }
+    size_t numSources() const { return m_num_sources; }
+    size_t numSpeakers() const { return m_num_speakers; }
+
+    /**
+     * Définit les délais et le facteur d'interpolation d'une route.
+     * @param source L'index de la source.
+     * @param speaker L'index du haut-parleur.
+     */
+    void setDelay(size_t source, size_t speaker, P tau1, P tau2, P alpha)
+    {
+        const size_t route = routeIndex(source, speaker);
+        const P      limit = static_cast<P>(m_max_delay_samples) - P(1);
+        if (tau1 < P(0) || tau1 >= limit) {
+            MTSD_THROW(std::out_of_range, "Tau1 must be between 0.0 and max_delay_samples - 1.0");
+        }
+        if (tau2 < P(0) || tau2 >= limit) {
+            MTSD_THROW(std::out_of_range, "Tau2 must be between 0.0 and max_delay_samples - 1.0");
+        }
+        if (alpha < P(0) || alpha > P(1)) {
+            MTSD_THROW(std::invalid_argument, "Alpha must be between 0.0 and 1.0.");
+        }
+        m_tau1[route]  = tau1;
+        m_tau2[route]  = tau2;
+        m_alpha[route] = alpha;
+    }
+
+    /**
+     * Définit le gain d'une route. Une route de gain nul n'est pas lue.
+     */
+    void setGain(size_t source, size_t speaker, T gain)
+    {
+        m_gain[routeIndex(source, speaker)] = gain;
+    }
+
+    P tau1(size_t source, size_t speaker) const { return m_tau1[routeIndex(source, speaker)]; }
+    P tau2(size_t source, size_t speaker) const { return m_tau2[routeIndex(source, speaker)]; }
+    P alpha(size_t source, size_t speaker) const { return m_alpha[routeIndex(source, speaker)]; }
+    T gain(size_t source, size_t speaker) const { return m_gain[routeIndex(source, speaker)]; }
+
+    /**
+     * Traite un bloc : chaque haut-parleur reçoit la somme des sources retardées et
+     * pondérées par leurs routes. Les paramètres sont constants sur le bloc.
+     * Le traitement en place (une sortie égale à une entrée) est supporté.
+     * @param ins Les N blocs d'entrée, un par source.
+     * @param outs Les M blocs de sortie, un par haut-parleur.
+     * @param n Le nombre d'échantillons du bloc.
+     */
+    void process(const T* const* ins, T* const* outs, size_t n) noexcept
+    {
+        updateRoutes();
+
+        const size_t num_taps = static_cast<size_t>(numTaps());
+        for (size_t start = 0; start < n; start += kMaxBlockSize) {
+            size_t count = std::min(kMaxBlockSize, n - start);
+            std::fill(m_bus.begin(), m_bus.end(), T(0));
+
+            for (size_t s = 0; s < m_num_sources; ++s) {
+                // Historique de la source écrit une fois, puis lu par toutes ses routes
+                SincDelayBuffer<T>& buffer     = m_buffers[s];
+                size_t              writeIndex = buffer.writeBlock(ins[s] + start, count);
+
+                for (size_t m = 0; m < m_num_speakers; ++m) {
+                    const size_t route = s * m_num_speakers + m;
+                    T*           bus   = &m_bus[m * kMaxBlockSize];
+                    if (m_gain[route] == T(0)) {
+                        continue;
+                    }
+                    if (m_fixed[route]) {
+                        buffer.accumulateTap(bus, writeIndex, m_tau1[route], m_gain[route], count);
+                        continue;
+                    }
+                    const P* delays = &m_tapDelays[route * num_taps];
+                    const T* gains  = &m_tapGains[route * num_taps];
+                    for (size_t k = 0; k < num_taps; ++k) {
+                        // Gains nuls (alpha à 0 ou 1) : tap non lu
+                        if (gains[k] != T(0)) {
+                            buffer.accumulateTap(bus, writeIndex, delays[k], gains[k], count);
+                        }
+                    }
+                }
+            }
+
+            // Toutes les entrées du sous-bloc sont lues avant d'écrire les sorties
+            for (size_t m = 0; m < m_num_speakers; ++m) {
+                const T* bus = &m_bus[m * kMaxBlockSize];
+                std::copy(bus, bus + count, outs[m] + start);
+            }
+        }
+    }
+
+    /**
+     * Retourne le surcoût mémoire des historiques (en octets) par rapport à
+     * N * max_delay_samples échantillons.
+     */
+    size_t memoryOverhead() const { return m_num_sources * m_buffers[0].memoryOverhead(); }
+
+    /**
+     * Force le jeu d'instructions des noyaux tap par tap (voir MultiTapSincDelay).
+     */
+    void setSimdLevel(SimdLevel level)
+    {
+        for (SincDelayBuffer<T>& buffer : m_buffers) {
+            buffer.setSimdLevel(level);
+        }
+    }
+
+    /**
+     * Retourne le jeu d'instructions utilisé par les noyaux tap par tap.
+     */
+    SimdLevel simdLevel() const { return m_buffers[0].simdLevel(); }
+
+   private:
+    size_t routeIndex(size_t source, size_t speaker) const
+    {
+        if (source >= m_num_sources || speaker >= m_num_speakers) {
+            MTSD_THROW(std::out_of_range, "Source or speaker index out of range.");
+        }
+        return source * m_num_speakers + speaker;
+    }
+
+    /**
+     * Calcule positions et gains des taps de toutes les routes actives, une fois par
+     * bloc. Le gain de la route est inclus dans les gains hk.
+     */
+    void updateRoutes() noexcept
+    {
+        const size_t num_taps    = static_cast<size_t>(numTaps());
+        const size_t buffer_size = m_buffers[0].size();
+        const P      epsilon     = std::numeric_limits<P>::epsilon() * 100;
+
+        for (size_t route = 0; route < m_tau1.size(); ++route) {
+            m_fixed[route] = std::abs(m_tau2[route] - m_tau1[route]) < epsilon;
+            if (m_fixed[route] || m_gain[route] == T(0)) {
+                continue;
+            }
+            P* delays = &m_tapDelays[route * num_taps];
+            T* gains  = &m_tapGains[route * num_taps];
+            sincTapPositions(m_K, m_tau1[route], m_tau2[route], P(0), buffer_size, delays);
+            if (m_gainTable) {
+                m_gainTable->gains(static_cast<double>(m_alpha[route]), gains);
+            } else {
+                sincGains(m_K, static_cast<double>(m_alpha[route]), gains);
+            }
+            for (size_t k = 0; k < num_taps; ++k) {
+                gains[k] *= m_gain[route];
+            }
+        }
+    }
+
+    size_t m_max_delay_samples;
+    size_t m_num_sources;
+    size_t m_num_speakers;
+    int    m_K;
+    P      m_sampleRate;
+
+    std::vector<SincDelayBuffer<T>> m_buffers;  // Un historique par source
+
+    // Paramètres des routes (SoA), indexés par source * M + haut-parleur
+    std::vector<P>    m_tau1;
+    std::vector<P>    m_tau2;
+    std::vector<P>    m_alpha;
+    std::vector<T>    m_gain;
+    std::vector<char> m_fixed;  // Délai fixe (tau1 == tau2) pour le bloc courant
+
+    // Taps des routes, 2K+2 par route, calculés une fois par bloc
+    std::vector<P> m_tapDelays;
+    std::vector<T> m_tapGains;
+
+    std::vector<T> m_bus;  // M bus de sommation d'un sous-bloc
+    std::shared_ptr<const SincGainTable> m_gainTable;
+};
+
+#endif  // WFS_RENDER_MATRIX_H